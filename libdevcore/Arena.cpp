@@ -0,0 +1,42 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Bump allocator for many small objects that share a lifetime.
+ */
+
+#include <libdevcore/Arena.h>
+
+using namespace std;
+using namespace dev;
+
+void* Arena::allocateChunk(size_t _size)
+{
+	// Oversized requests get a chunk of their own, so that the rest of the current chunk
+	// can still be used.
+	if (_size > m_chunkSize / 4)
+	{
+		m_chunks.emplace_back(new char[_size]);
+		m_reservedBytes += _size;
+		return m_chunks.back().get();
+	}
+	m_chunks.emplace_back(new char[m_chunkSize]);
+	m_reservedBytes += m_chunkSize;
+	m_current = m_chunks.back().get();
+	m_currentSize = m_chunkSize;
+	m_used = _size;
+	return m_current;
+}
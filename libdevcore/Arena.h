@@ -0,0 +1,97 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Bump allocator for many small objects that share a lifetime.
+ */
+
+#pragma once
+
+#include <boost/noncopyable.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace dev
+{
+
+/**
+ * Hands out memory from large chunks and releases all chunks at once when it is destroyed.
+ * Individual deallocations are no-ops. Not thread-safe.
+ */
+class Arena: boost::noncopyable
+{
+public:
+	explicit Arena(size_t _chunkSize = 64 * 1024): m_chunkSize(_chunkSize) {}
+
+	/// @returns @a _size bytes of memory aligned to @a _alignment, which has to be
+	/// a power of two not larger than alignof(std::max_align_t).
+	void* allocate(size_t _size, size_t _alignment)
+	{
+		size_t offset = (m_used + _alignment - 1) & ~(_alignment - 1);
+		if (offset + _size <= m_currentSize)
+		{
+			m_used = offset + _size;
+			return m_current + offset;
+		}
+		return allocateChunk(_size);
+	}
+
+	/// @returns the total size of all chunks allocated so far.
+	size_t reservedBytes() const { return m_reservedBytes; }
+
+private:
+	void* allocateChunk(size_t _size);
+
+	size_t m_chunkSize;
+	std::vector<std::unique_ptr<char[]>> m_chunks;
+	char* m_current = nullptr;
+	size_t m_currentSize = 0;
+	size_t m_used = 0;
+	size_t m_reservedBytes = 0;
+};
+
+/**
+ * Standard allocator that allocates from an arena it co-owns.
+ * Used with std::allocate_shared, every object keeps its arena alive, so the memory
+ * of all objects is released in bulk once the last of them is destroyed.
+ */
+template <class T>
+class ArenaAllocator
+{
+public:
+	using value_type = T;
+
+	explicit ArenaAllocator(std::shared_ptr<Arena> _arena): m_arena(std::move(_arena)) {}
+	template <class U>
+	ArenaAllocator(ArenaAllocator<U> const& _other): m_arena(_other.arena()) {}
+
+	T* allocate(size_t _count) { return static_cast<T*>(m_arena->allocate(_count * sizeof(T), alignof(T))); }
+	void deallocate(T*, size_t) {}
+
+	std::shared_ptr<Arena> const& arena() const { return m_arena; }
+
+	template <class U>
+	bool operator==(ArenaAllocator<U> const& _other) const { return m_arena == _other.arena(); }
+	template <class U>
+	bool operator!=(ArenaAllocator<U> const& _other) const { return m_arena != _other.arena(); }
+
+private:
+	std::shared_ptr<Arena> m_arena;
+};
+
+}
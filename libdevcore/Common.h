@@ -47,6 +47,7 @@
 #include <boost/multiprecision/cpp_int.hpp>
 
 #include <map>
+#include <memory>
 #include <vector>
 #include <functional>
 #include <string>
@@ -67,6 +68,8 @@ using u160 = boost::multiprecision::number<boost::multiprecision::cpp_int_backen
 
 // Map types.
 using StringMap = std::map<std::string, std::string>;
+/// Map of names to immutable strings that are shared instead of copied.
+using SharedStringMap = std::map<std::string, std::shared_ptr<std::string const>>;
 
 // String types.
 using strings = std::vector<std::string>;
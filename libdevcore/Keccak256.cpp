@@ -21,10 +21,12 @@
 
 #include <libdevcore/Keccak256.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <numeric>
 
 using namespace std;
 using namespace dev;
@@ -170,6 +172,197 @@ inline void hash(
 	memset(a, 0, 200);
 }
 
+/******** Multi-input hashing. ********/
+
+/// Input of the multi-input sponge: the concatenation of two byte ranges.
+using SpongeInput = pair<bytesConstRef, bytesConstRef>;
+
+/// The "rate" of Keccak-256, i.e. the number of input bytes absorbed per permutation.
+size_t constexpr c_rate = 200 - (256 / 4);
+
+/// @returns the number of permutations needed to absorb @a _input, including the padding.
+size_t blockCount(SpongeInput const& _input)
+{
+	return (_input.first.size() + _input.second.size()) / c_rate + 1;
+}
+
+/// @returns a pointer to the @a _block -th rate-sized block of the padded @a _input.
+/// Points into the input itself if possible, otherwise the block is assembled in @a _buffer.
+uint8_t const* spongeBlock(SpongeInput const& _input, size_t _block, uint8_t* _buffer)
+{
+	size_t const length = _input.first.size() + _input.second.size();
+	size_t const begin = _block * c_rate;
+	size_t const firstSize = _input.first.size();
+	if (begin + c_rate <= firstSize)
+		return _input.first.data() + begin;
+	if (begin >= firstSize && begin + c_rate <= length)
+		return _input.second.data() + (begin - firstSize);
+
+	memset(_buffer, 0, c_rate);
+	size_t const end = min(begin + c_rate, length);
+	for (size_t i = begin; i < end; ++i)
+		_buffer[i - begin] = i < firstSize ? _input.first[i] : _input.second[i - firstSize];
+	if (_block + 1 == blockCount(_input))
+	{
+		_buffer[end - begin] ^= 0x01;
+		_buffer[c_rate - 1] ^= 0x80;
+	}
+	return _buffer;
+}
+
+/// Scalar Keccak-256 of a single sponge input.
+h256 hashSingle(SpongeInput const& _input)
+{
+	uint8_t a[Plen] = {0};
+	uint8_t buffer[c_rate];
+	for (size_t block = 0; block < blockCount(_input); ++block)
+	{
+		xorin(a, spongeBlock(_input, block, buffer), c_rate);
+		P(a);
+	}
+	h256 output;
+	setout(a, output.data(), output.size);
+	return output;
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+
+#define DEV_KECCAK_MULTI_LANE 1
+
+/// Number of Keccak states permuted at once.
+size_t constexpr c_lanes = 4;
+
+/// Word of c_lanes independent Keccak states. A state array of 25 of these holds word w
+/// of state l in `state[w][l]`, so every operation of the permutation is one vector operation.
+typedef uint64_t LaneVector __attribute__((vector_size(8 * c_lanes)));
+
+/// Keccak-f[1600] on c_lanes interleaved states.
+/// Always inlined so that it is compiled separately for every target it is used in.
+static inline __attribute__((always_inline)) void keccakfLanes(LaneVector* _a)
+{
+	LaneVector b[5];
+	for (size_t round = 0; round < 24; round++)
+	{
+		// Theta
+		for (size_t x = 0; x < 5; x++)
+			b[x] = _a[x] ^ _a[x + 5] ^ _a[x + 10] ^ _a[x + 15] ^ _a[x + 20];
+		for (size_t x = 0; x < 5; x++)
+		{
+			LaneVector const d = b[(x + 4) % 5] ^ rol(b[(x + 1) % 5], 1);
+			for (size_t y = 0; y < 25; y += 5)
+				_a[y + x] ^= d;
+		}
+		// Rho and pi
+		LaneVector t = _a[1];
+		for (size_t x = 0; x < 24; x++)
+		{
+			b[0] = _a[pi[x]];
+			_a[pi[x]] = rol(t, rho[x]);
+			t = b[0];
+		}
+		// Chi
+		for (size_t y = 0; y < 25; y += 5)
+		{
+			for (size_t x = 0; x < 5; x++)
+				b[x] = _a[y + x];
+			for (size_t x = 0; x < 5; x++)
+				_a[y + x] = b[x] ^ (~b[(x + 1) % 5] & b[(x + 2) % 5]);
+		}
+		// Iota
+		_a[0] ^= RC[round];
+	}
+}
+
+void keccakfLanesDefault(LaneVector* _a)
+{
+	keccakfLanes(_a);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("avx2"))) void keccakfLanesAVX2(LaneVector* _a)
+{
+	keccakfLanes(_a);
+}
+#endif
+
+/// @returns the multi-lane permutation best suited for the current CPU.
+void (*selectKeccakfLanes())(LaneVector*)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	if (__builtin_cpu_supports("avx2"))
+		return keccakfLanesAVX2;
+#endif
+	return keccakfLanesDefault;
+}
+
+/// Hashes the inputs at @a _indices (at most c_lanes of them) in parallel lanes
+/// and stores the results in the corresponding positions of @a _hashes.
+void hashLanes(vector<SpongeInput> const& _inputs, size_t const* _indices, size_t _count, vector<h256>& _hashes)
+{
+	static void (*permute)(LaneVector*) = selectKeccakfLanes();
+
+	LaneVector state[25] = {};
+	size_t blocks[c_lanes] = {};
+	size_t maxBlocks = 0;
+	for (size_t lane = 0; lane < _count; ++lane)
+	{
+		blocks[lane] = blockCount(_inputs[_indices[lane]]);
+		maxBlocks = max(maxBlocks, blocks[lane]);
+	}
+
+	uint8_t buffer[c_rate];
+	for (size_t block = 0; block < maxBlocks; ++block)
+	{
+		for (size_t lane = 0; lane < _count; ++lane)
+			if (block < blocks[lane])
+			{
+				uint8_t const* data = spongeBlock(_inputs[_indices[lane]], block, buffer);
+				for (size_t word = 0; word < c_rate / 8; ++word)
+				{
+					uint64_t value;
+					memcpy(&value, data + 8 * word, 8);
+					state[word][lane] ^= value;
+				}
+			}
+		permute(state);
+		for (size_t lane = 0; lane < _count; ++lane)
+			if (block + 1 == blocks[lane])
+				for (size_t word = 0; word < h256::size / 8; ++word)
+				{
+					uint64_t value = state[word][lane];
+					memcpy(_hashes[_indices[lane]].data() + 8 * word, &value, 8);
+				}
+	}
+}
+
+#endif
+
+vector<h256> hashMany(vector<SpongeInput> const& _inputs)
+{
+	vector<h256> hashes(_inputs.size());
+#if DEV_KECCAK_MULTI_LANE
+	// Process inputs of similar length together, so that few lanes idle
+	// while the longest input of a group is absorbed.
+	vector<size_t> order(_inputs.size());
+	iota(order.begin(), order.end(), 0);
+	stable_sort(order.begin(), order.end(), [&](size_t _a, size_t _b) {
+		return blockCount(_inputs[_a]) < blockCount(_inputs[_b]);
+	});
+	for (size_t i = 0; i < order.size(); i += c_lanes)
+	{
+		size_t const count = min(c_lanes, order.size() - i);
+		if (count == 1)
+			hashes[order[i]] = hashSingle(_inputs[order[i]]);
+		else
+			hashLanes(_inputs, order.data() + i, count, hashes);
+	}
+#else
+	for (size_t i = 0; i < _inputs.size(); ++i)
+		hashes[i] = hashSingle(_inputs[i]);
+#endif
+	return hashes;
+}
+
 }
 
 h256 keccak256(bytesConstRef _input)
@@ -183,4 +376,18 @@ h256 keccak256(bytesConstRef _input)
 	return output;
 }
 
+vector<h256> keccak256Many(vector<bytesConstRef> const& _inputs)
+{
+	vector<SpongeInput> inputs;
+	inputs.reserve(_inputs.size());
+	for (auto const& input: _inputs)
+		inputs.emplace_back(input, bytesConstRef());
+	return hashMany(inputs);
+}
+
+vector<h256> keccak256Many(vector<pair<bytesConstRef, bytesConstRef>> const& _inputs)
+{
+	return hashMany(_inputs);
+}
+
 }
@@ -0,0 +1,103 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Helpers to run independent pieces of work concurrently.
+ */
+
+#include <libdevcore/Parallel.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace dev;
+
+namespace
+{
+/// Set while the current thread runs the body of a parallelFor. Nested loops then run
+/// sequentially instead of multiplying the number of threads.
+thread_local bool s_insideParallelFor = false;
+}
+
+size_t dev::workerCount(size_t _tasks)
+{
+#ifdef __EMSCRIPTEN__
+	(void)_tasks;
+	return 1;
+#else
+	if (s_insideParallelFor)
+		return 1;
+	size_t hardwareThreads = thread::hardware_concurrency();
+	return max<size_t>(1, min(_tasks, hardwareThreads));
+#endif
+}
+
+void dev::parallelFor(size_t _count, function<void(size_t)> const& _body)
+{
+	size_t const workers = workerCount(_count);
+	if (workers <= 1)
+	{
+		for (size_t i = 0; i < _count; ++i)
+			_body(i);
+		return;
+	}
+
+	atomic<size_t> next{0};
+	atomic<bool> failed{false};
+	exception_ptr firstException;
+	mutex exceptionMutex;
+	auto work = [&]()
+	{
+		s_insideParallelFor = true;
+		for (size_t i = next++; i < _count && !failed; i = next++)
+			try
+			{
+				_body(i);
+			}
+			catch (...)
+			{
+				lock_guard<mutex> lock(exceptionMutex);
+				if (!firstException)
+					firstException = current_exception();
+				failed = true;
+			}
+		s_insideParallelFor = false;
+	};
+
+	vector<thread> threads;
+	for (size_t i = 1; i < workers; ++i)
+		try
+		{
+			threads.emplace_back(work);
+		}
+		catch (system_error const&)
+		{
+			// Continue with the threads that could be started.
+			break;
+		}
+	work();
+	for (thread& t: threads)
+		t.join();
+
+	if (firstException)
+		rethrow_exception(firstException);
+}
@@ -0,0 +1,39 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Helpers to run independent pieces of work concurrently.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace dev
+{
+
+/// @returns the number of worker threads to use for at most @a _tasks independent tasks.
+/// Always returns 1 on platforms without thread support and inside the body of a parallelFor.
+size_t workerCount(size_t _tasks);
+
+/// Calls @a _body for every index in [0, _count), distributing the calls over up to
+/// workerCount(_count) threads. The calls must be independent of each other.
+/// If any call throws, the remaining indices are skipped and the first exception
+/// is rethrown once all threads have finished.
+void parallelFor(size_t _count, std::function<void(size_t)> const& _body);
+
+}
@@ -35,35 +35,41 @@ bytes toLittleEndian(size_t _size)
 	return encoded;
 }
 
-h256 swarmHashSimple(bytesConstRef _data, size_t _size)
+/// Computes the hash of the subtree covering @a _length bytes starting at @a _offset,
+/// given the hashes of all 4096 byte leaf chunks of the input.
+h256 swarmHashIntermediate(vector<h256> const& _leafHashes, size_t _offset, size_t _length)
 {
-	return keccak256(toLittleEndian(_size) + _data.toBytes());
-}
+	if (_length <= 0x1000)
+		return _leafHashes[_offset / 0x1000];
 
-h256 swarmHashIntermediate(string const& _input, size_t _offset, size_t _length)
-{
-	bytesConstRef ref;
 	bytes innerNodes;
-	if (_length <= 0x1000)
-		ref = bytesConstRef(_input).cropped(_offset, _length);
-	else
+	size_t maxRepresentedSize = 0x1000;
+	while (maxRepresentedSize * (0x1000 / 32) < _length)
+		maxRepresentedSize *= (0x1000 / 32);
+	for (size_t i = 0; i < _length; i += maxRepresentedSize)
 	{
-		size_t maxRepresentedSize = 0x1000;
-		while (maxRepresentedSize * (0x1000 / 32) < _length)
-			maxRepresentedSize *= (0x1000 / 32);
-		for (size_t i = 0; i < _length; i += maxRepresentedSize)
-		{
-			size_t size = std::min(maxRepresentedSize, _length - i);
-			innerNodes += swarmHashIntermediate(_input, _offset + i, size).asBytes();
-		}
-		ref = bytesConstRef(&innerNodes);
+		size_t size = std::min(maxRepresentedSize, _length - i);
+		innerNodes += swarmHashIntermediate(_leafHashes, _offset + i, size).asBytes();
 	}
-	return swarmHashSimple(ref, _length);
+	return keccak256(toLittleEndian(_length) + innerNodes);
 }
 
 }
 
 h256 dev::swarmHash(string const& _input)
 {
-	return swarmHashIntermediate(_input, 0, _input.size());
+	// The leaves of the tree are the consecutive 4096 byte chunks of the input, each
+	// prefixed by its length. They are hashed together, directly from the input.
+	bytesConstRef input(_input);
+	size_t const leafCount = std::max<size_t>(1, (input.size() + 0x0fff) / 0x1000);
+	bytes const fullLeafSize = toLittleEndian(0x1000);
+	bytes const lastLeafSize = toLittleEndian(input.size() - (leafCount - 1) * 0x1000);
+	vector<pair<bytesConstRef, bytesConstRef>> leaves;
+	leaves.reserve(leafCount);
+	for (size_t i = 0; i < leafCount; ++i)
+		leaves.emplace_back(
+			bytesConstRef(i + 1 == leafCount ? &lastLeafSize : &fullLeafSize),
+			input.cropped(i * 0x1000, std::min<size_t>(0x1000, input.size() - i * 0x1000))
+		);
+	return swarmHashIntermediate(keccak256Many(leaves), 0, input.size());
 }
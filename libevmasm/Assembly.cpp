@@ -29,6 +29,8 @@
 #include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/GasMeter.h>
 
+#include <libdevcore/Parallel.h>
+
 #include <fstream>
 #include <json/json.h>
 
@@ -112,16 +114,16 @@ unsigned Assembly::bytesRequired(unsigned subTagSize) const
 namespace
 {
 
-string locationFromSources(StringMap const& _sourceCodes, SourceLocation const& _location)
+string locationFromSources(SharedStringMap const& _sourceCodes, SourceLocation const& _location)
 {
 	if (_location.isEmpty() || !_location.source.get() || _sourceCodes.empty() || _location.start >= _location.end || _location.start < 0)
 		return "";
 
 	auto it = _sourceCodes.find(_location.source->name());
-	if (it == _sourceCodes.end())
+	if (it == _sourceCodes.end() || !it->second)
 		return "";
 
-	string const& source = it->second;
+	string const& source = *it->second;
 	if (size_t(_location.start) >= source.size())
 		return "";
 
@@ -136,7 +138,7 @@ string locationFromSources(StringMap const& _sourceCodes, SourceLocation const&
 class Functionalizer
 {
 public:
-	Functionalizer (ostream& _out, string const& _prefix, StringMap const& _sourceCodes):
+	Functionalizer (ostream& _out, string const& _prefix, SharedStringMap const& _sourceCodes):
 		m_out(_out), m_prefix(_prefix), m_sourceCodes(_sourceCodes)
 	{}
 
@@ -203,12 +205,12 @@ private:
 
 	ostream& m_out;
 	string const& m_prefix;
-	StringMap const& m_sourceCodes;
+	SharedStringMap const& m_sourceCodes;
 };
 
 }
 
-void Assembly::assemblyStream(ostream& _out, string const& _prefix, StringMap const& _sourceCodes) const
+void Assembly::assemblyStream(ostream& _out, string const& _prefix, SharedStringMap const& _sourceCodes) const
 {
 	Functionalizer f(_out, _prefix, _sourceCodes);
 
@@ -235,7 +237,7 @@ void Assembly::assemblyStream(ostream& _out, string const& _prefix, StringMap co
 		_out << endl << _prefix << "auxdata: 0x" << toHex(m_auxiliaryData) << endl;
 }
 
-string Assembly::assemblyString(StringMap const& _sourceCodes) const
+string Assembly::assemblyString(SharedStringMap const& _sourceCodes) const
 {
 	ostringstream tmp;
 	assemblyStream(tmp, "", _sourceCodes);
@@ -262,7 +264,7 @@ string Assembly::toStringInHex(u256 _value)
 	return hexStr.str();
 }
 
-Json::Value Assembly::assemblyJSON(StringMap const& _sourceCodes) const
+Json::Value Assembly::assemblyJSON(SharedStringMap const& _sourceCodes) const
 {
 	Json::Value root;
 
@@ -388,24 +390,120 @@ Assembly& Assembly::optimise(OptimiserSettings const& _settings)
 	return *this;
 }
 
+namespace
+{
+
+/// @returns the tags that can only be reached by falling through or by jumps that are located
+/// before the tag and take the tag, pushed directly before, as their target. The knowledge
+/// about the state at such a tag can be determined in a single pass over the code.
+/// If a jump takes a plain constant as its target, no tag qualifies. Other jumps to values
+/// that are not pushed directly before are assumed to only target tags that are pushed
+/// elsewhere, which is the case for all code generated by the compiler.
+set<size_t> forwardJumpTargets(AssemblyItems const& _items, set<size_t> const& _tagsReferencedFromOutside)
+{
+	set<size_t> definedTags;
+	set<size_t> excludedTags = _tagsReferencedFromOutside;
+	for (size_t i = 0; i < _items.size(); ++i)
+	{
+		AssemblyItem const& item = _items[i];
+		bool jumpFollows = i + 1 < _items.size() && (
+			_items[i + 1] == Instruction::JUMP ||
+			_items[i + 1] == Instruction::JUMPI
+		);
+		if (item.type() == Push && jumpFollows)
+			return {};
+		else if (item.type() == PushTag)
+		{
+			size_t subId;
+			size_t tag;
+			tie(subId, tag) = item.splitForeignPushTag();
+			if (subId == size_t(-1) && (!jumpFollows || definedTags.count(tag)))
+				excludedTags.insert(tag);
+		}
+		else if (item.type() == Tag)
+			definedTags.insert(size_t(item.data()));
+	}
+	set<size_t> tags;
+	for (size_t tag: definedTags)
+		if (!excludedTags.count(tag))
+			tags.insert(tag);
+	return tags;
+}
+
+/// @returns true if @a _item loads a value from storage or memory (or hashes memory) at a location
+/// whose content is known in @a _current, the state before @a _item, and has been known
+/// with the same value already in @a _initial.
+bool loadsKnownValue(KnownState const& _initial, KnownState& _current, AssemblyItem const& _item)
+{
+	bool fromStorage = _item == Instruction::SLOAD;
+	if (!fromStorage && _item != Instruction::MLOAD && _item != Instruction::KECCAK256)
+		return false;
+	map<KnownState::Id, KnownState::Id> const& initialContent =
+		fromStorage ? _initial.storageContent() : _initial.memoryContent();
+	map<KnownState::Id, KnownState::Id> const& content =
+		fromStorage ? _current.storageContent() : _current.memoryContent();
+	KnownState::Id location = _current.relativeStackElement(0);
+	auto it = content.find(location);
+	return it != content.end() && initialContent.count(location) && initialContent.at(location) == it->second;
+}
+
+/// Runs the common subexpression eliminator on the block starting at @a _iter, starting
+/// with the knowledge @a _initialState, and moves @a _iter to the end of the block.
+/// @returns true if the optimised code @a _optimised is shorter than the original.
+bool eliminateCommonSubexpressions(
+	KnownState const& _initialState,
+	AssemblyItems::iterator& _iter,
+	AssemblyItems::iterator _end,
+	bool _usesMSize,
+	AssemblyItems& _optimised
+)
+{
+	CommonSubexpressionEliminator eliminator{_initialState};
+	auto orig = _iter;
+	_iter = eliminator.feedItems(_iter, _end, _usesMSize);
+	try
+	{
+		_optimised = eliminator.getOptimizedItems();
+		return _optimised.size() < size_t(_iter - orig);
+	}
+	catch (StackTooDeepException const&)
+	{
+		// This might happen if the opcode reconstruction is not as efficient
+		// as the hand-crafted code.
+	}
+	catch (ItemNotAvailableException const&)
+	{
+		// This might happen if e.g. associativity and commutativity rules
+		// reorganise the expression tree, but not all leaves are available.
+	}
+	return false;
+}
+
+}
+
 map<u256, u256> Assembly::optimiseInternal(
 	OptimiserSettings const& _settings,
 	std::set<size_t> _tagsReferencedFromOutside
 )
 {
-	// Run optimisation for sub-assemblies.
+	// Run optimisation for sub-assemblies. Groups of sub-assemblies that do not share any
+	// assembly are optimised concurrently, the subs within a group in order.
+	OptimiserSettings subSettings = _settings;
+	// Disable creation mode for sub-assemblies.
+	subSettings.isCreation = false;
+	vector<set<size_t>> subReferencedTags;
 	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		subReferencedTags.push_back(JumpdestRemover::referencedTags(m_items, subId));
+	vector<map<u256, u256>> subTagReplacements(m_subs.size());
+	vector<vector<size_t>> groups = independentSubGroups();
+	parallelFor(groups.size(), [&](size_t _group)
 	{
-		OptimiserSettings settings = _settings;
-		// Disable creation mode for sub-assemblies.
-		settings.isCreation = false;
-		map<u256, u256> subTagReplacements = m_subs[subId]->optimiseInternal(
-			settings,
-			JumpdestRemover::referencedTags(m_items, subId)
-		);
-		// Apply the replacements (can be empty).
-		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
-	}
+		for (size_t subId: groups[_group])
+			subTagReplacements[subId] = m_subs[subId]->optimiseInternal(subSettings, subReferencedTags[subId]);
+	});
+	// Apply the replacements (can be empty).
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements[subId], subId);
 
 	map<u256, u256> tagReplacements;
 	// Iterate until no new optimisation possibilities are found.
@@ -461,33 +559,81 @@ map<u256, u256> Assembly::optimiseInternal(
 			// Control flow graph optimization has been here before but is disabled because it
 			// assumes we only jump to tags that are pushed. This is not the case anymore with
 			// function types that can be stored in storage.
+			// Knowledge about storage and memory is only carried into the block following
+			// a tag if all ways to reach that tag are known (see forwardJumpTargets).
 			AssemblyItems optimisedItems;
 
 			bool usesMSize = (find(m_items.begin(), m_items.end(), AssemblyItem{Instruction::MSIZE}) != m_items.end());
 
+			set<size_t> const joinableTags =
+				usesMSize ? set<size_t>{} : forwardJumpTargets(m_items, _tagsReferencedFromOutside);
+			// Knowledge that is combined across blocks has to use the same expression classes.
+			// Each region of code that starts with partial knowledge of the stack gets its own
+			// classes for the unknown stack elements. Otherwise, a stack element dropped at a join
+			// would get the class of the element at the same height at the start of another
+			// region, and storage or memory keyed on that class would be attributed to it.
+			auto expressionClasses = make_shared<ExpressionClasses>();
+			unsigned stackRegions = 0;
+			auto newKnowledge = [&]()
+			{
+				auto state = make_shared<KnownState>(expressionClasses);
+				state->setStackRegion(++stackRegions);
+				return state;
+			};
+			// Common knowledge of all jumps to joinable tags seen so far.
+			map<size_t, KnownStatePointer> knowledgeAtTag;
+			// Knowledge at the current position, null if it cannot be reached by falling through
+			// or if knowledge is not propagated at all.
+			KnownStatePointer knowledge;
+			if (!usesMSize)
+				knowledge = newKnowledge();
+
 			auto iter = m_items.begin();
 			while (iter != m_items.end())
 			{
-				KnownState emptyState;
-				CommonSubexpressionEliminator eliminator{emptyState};
 				auto orig = iter;
-				iter = eliminator.feedItems(iter, m_items.end(), usesMSize);
-				bool shouldReplace = false;
 				AssemblyItems optimisedChunk;
-				try
-				{
-					optimisedChunk = eliminator.getOptimizedItems();
-					shouldReplace = (optimisedChunk.size() < size_t(iter - orig));
-				}
-				catch (StackTooDeepException const&)
+				KnownState emptyState;
+				bool shouldReplace = eliminateCommonSubexpressions(emptyState, iter, m_items.end(), usesMSize, optimisedChunk);
+
+				AssemblyItem const& lastItem = *prev(iter);
+				KnownStatePointer initialKnowledge;
+				bool loadsKnownValues = false;
+				if (knowledge)
 				{
-					// This might happen if the opcode reconstruction is not as efficient
-					// as the hand-crafted code.
+					initialKnowledge = knowledge->copy();
+					if (
+						lastItem.type() != Operation &&
+						lastItem.type() != Tag &&
+						SemanticInformation::breaksCSEAnalysisBlock(lastItem, usesMSize)
+					)
+						knowledge = newKnowledge();
+					else
+						for (auto it = orig; it != iter; ++it)
+						{
+							loadsKnownValues = loadsKnownValues || loadsKnownValue(*initialKnowledge, *knowledge, *it);
+							knowledge->feedItem(*it);
+						}
 				}
-				catch (ItemNotAvailableException const&)
+				if (loadsKnownValues)
 				{
-					// This might happen if e.g. associativity and commutativity rules
-					// reorganise the expression tree, but not all leaves are available.
+					// Only use the knowledge from other blocks if it results in code that is both
+					// shorter and not larger in bytes. Otherwise, e.g. a keccak256 of known memory
+					// content would be replaced by a 32 byte constant.
+					AssemblyItems withKnowledge;
+					auto end = orig;
+					if (eliminateCommonSubexpressions(*initialKnowledge, end, m_items.end(), usesMSize, withKnowledge))
+					{
+						AssemblyItems const& alternative = shouldReplace ? optimisedChunk : AssemblyItems(orig, iter);
+						if (
+							withKnowledge.size() < alternative.size() &&
+							eth::bytesRequired(withKnowledge, 3) <= eth::bytesRequired(alternative, 3)
+						)
+						{
+							optimisedChunk = move(withKnowledge);
+							shouldReplace = true;
+						}
+					}
 				}
 
 				if (shouldReplace)
@@ -497,6 +643,54 @@ map<u256, u256> Assembly::optimiseInternal(
 				}
 				else
 					copy(orig, iter, back_inserter(optimisedItems));
+
+				if (usesMSize)
+					continue;
+				if (lastItem.type() == Tag)
+				{
+					size_t tag = size_t(lastItem.data());
+					KnownStatePointer joined;
+					if (joinableTags.count(tag))
+					{
+						joined = knowledgeAtTag[tag];
+						if (joined && knowledge)
+							joined->reduceToCommonKnowledge(*knowledge, true);
+						else if (!joined)
+							joined = knowledge;
+					}
+					if (joined)
+					{
+						// Tag unions cannot be regenerated by the code generator.
+						joined->clearTagUnions();
+						joined->setStackRegion(++stackRegions);
+					}
+					else
+						joined = newKnowledge();
+					knowledge = joined;
+				}
+				else if (knowledge)
+				{
+					if (
+						(lastItem == Instruction::JUMP || lastItem == Instruction::JUMPI) &&
+						iter - orig >= 2 &&
+						prev(iter, 2)->type() == PushTag
+					)
+					{
+						size_t subId;
+						size_t tag;
+						tie(subId, tag) = prev(iter, 2)->splitForeignPushTag();
+						if (subId == size_t(-1) && joinableTags.count(tag))
+						{
+							KnownStatePointer& atTag = knowledgeAtTag[tag];
+							if (atTag)
+								atTag->reduceToCommonKnowledge(*knowledge, true);
+							else
+								atTag = knowledge->copy();
+						}
+					}
+					if (SemanticInformation::terminatesControlFlow(lastItem))
+						knowledge.reset();
+				}
 			}
 			if (optimisedItems.size() < m_items.size())
 			{
@@ -517,6 +711,73 @@ map<u256, u256> Assembly::optimiseInternal(
 	return tagReplacements;
 }
 
+vector<vector<size_t>> Assembly::independentSubGroups() const
+{
+	// Union-find over the sub indices, merging two subs if they reach a common assembly.
+	vector<size_t> parent(m_subs.size());
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		parent[subId] = subId;
+	auto root = [&](size_t _subId)
+	{
+		while (parent[_subId] != _subId)
+			_subId = parent[_subId] = parent[parent[_subId]];
+		return _subId;
+	};
+
+	map<Assembly const*, size_t> owner;
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+	{
+		set<Assembly const*> reachable;
+		m_subs[subId]->collectAssemblies(reachable);
+		for (Assembly const* assembly: reachable)
+		{
+			auto inserted = owner.emplace(assembly, subId);
+			if (!inserted.second)
+			{
+				size_t a = root(inserted.first->second);
+				size_t b = root(subId);
+				parent[max(a, b)] = min(a, b);
+			}
+		}
+	}
+
+	vector<vector<size_t>> groups;
+	map<size_t, size_t> groupOfRoot;
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+	{
+		auto group = groupOfRoot.emplace(root(subId), groups.size());
+		if (group.second)
+			groups.emplace_back();
+		groups[group.first->second].push_back(subId);
+	}
+	return groups;
+}
+
+void Assembly::collectAssemblies(set<Assembly const*>& _assemblies) const
+{
+	if (!_assemblies.insert(this).second)
+		return;
+	for (auto const& sub: m_subs)
+		sub->collectAssemblies(_assemblies);
+}
+
+void Assembly::replaceAuxiliaryData(map<bytes, bytes> const& _replacements)
+{
+	auto replacement = _replacements.find(m_auxiliaryData);
+	if (replacement != _replacements.end())
+		m_auxiliaryData = replacement->second;
+	for (auto const& sub: m_subs)
+		sub->replaceAuxiliaryData(_replacements);
+}
+
+void Assembly::discardAssembledObject()
+{
+	m_assembledObject = LinkerObject();
+	m_tagPositionsInBytecode.clear();
+	for (auto const& sub: m_subs)
+		sub->discardAssembledObject();
+}
+
 LinkerObject const& Assembly::assemble() const
 {
 	if (!m_assembledObject.bytecode.empty())
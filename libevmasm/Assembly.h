@@ -32,6 +32,7 @@
 #include <json/json.h>
 
 #include <iostream>
+#include <map>
 #include <sstream>
 #include <memory>
 
@@ -82,6 +83,10 @@ public:
 
 	/// Appends @a _data literally to the very end of the bytecode.
 	void appendAuxiliaryDataToEnd(bytes const& _data) { m_auxiliaryData += _data; }
+	/// Replaces the data appended to the very end of the bytecode of this and all sub-assemblies
+	/// by its value in @a _replacements, if present. The assembled object has to be discarded
+	/// using @a discardAssembledObject before assembling again.
+	void replaceAuxiliaryData(std::map<bytes, bytes> const& _replacements);
 
 	/// Returns the assembly items.
 	AssemblyItems const& items() const { return m_items; }
@@ -98,6 +103,8 @@ public:
 
 	/// Assembles the assembly into bytecode. The assembly should not be modified after this call, since the assembled version is cached.
 	LinkerObject const& assemble() const;
+	/// Discards the cached assembled objects of this assembly and all sub-assemblies.
+	void discardAssembledObject();
 
 	struct OptimiserSettings
 	{
@@ -126,17 +133,17 @@ public:
 
 	/// Create a text representation of the assembly.
 	std::string assemblyString(
-		StringMap const& _sourceCodes = StringMap()
+		SharedStringMap const& _sourceCodes = SharedStringMap()
 	) const;
 	void assemblyStream(
 		std::ostream& _out,
 		std::string const& _prefix = "",
-		StringMap const& _sourceCodes = StringMap()
+		SharedStringMap const& _sourceCodes = SharedStringMap()
 	) const;
 
 	/// Create a JSON representation of the assembly.
 	Json::Value assemblyJSON(
-		StringMap const& _sourceCodes = StringMap()
+		SharedStringMap const& _sourceCodes = SharedStringMap()
 	) const;
 
 public:
@@ -157,6 +164,12 @@ protected:
 	/// that are referenced in a super-assembly.
 	std::map<u256, u256> optimiseInternal(OptimiserSettings const& _settings, std::set<size_t> _tagsReferencedFromOutside);
 
+	/// Partitions the indices of the sub-assemblies into groups such that no assembly is reachable
+	/// from two different groups. Groups and the indices in them are in ascending order.
+	std::vector<std::vector<size_t>> independentSubGroups() const;
+	/// Inserts this assembly and all assemblies reachable through its sub-assemblies into @a _assemblies.
+	void collectAssemblies(std::set<Assembly const*>& _assemblies) const;
+
 	unsigned bytesRequired(unsigned subTagSize) const;
 
 private:
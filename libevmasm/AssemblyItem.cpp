@@ -21,10 +21,12 @@
 #include <libdevcore/FixedHash.h>
 
 #include <fstream>
+#include <unordered_map>
 
 using namespace std;
 using namespace dev;
 using namespace dev::eth;
+using namespace langutil;
 
 static_assert(sizeof(size_t) <= 8, "size_t must be at most 64-bits wide");
 
@@ -225,6 +227,115 @@ string AssemblyItem::toAssemblyText() const
 	return text;
 }
 
+namespace
+{
+
+/// Appends the decimal representation of @a _value to @a _out without a temporary string.
+void appendNumber(string& _out, int _value)
+{
+	char buffer[12];
+	char* end = buffer + sizeof(buffer);
+	char* begin = end;
+	unsigned value = _value < 0 ? 0u - unsigned(_value) : unsigned(_value);
+	do
+		*--begin = char('0' + value % 10);
+	while (value /= 10);
+	if (_value < 0)
+		*--begin = '-';
+	_out.append(begin, end);
+}
+
+}
+
+string dev::eth::computeSourceMapping(AssemblyItems const& _items, map<string, unsigned> const& _sourceIndices)
+{
+	string ret;
+	// Most entries are empty or only differ in the start offset.
+	ret.reserve(_items.size() * 4);
+	// The source indices by char stream, so that the names are only looked up once per source.
+	unordered_map<CharStream const*, int> sourceIndexCache;
+	CharStream const* prevSource = nullptr;
+	int prevStart = -1;
+	int prevLength = -1;
+	int prevSourceIndex = -1;
+	char prevJump = 0;
+	for (auto const& item: _items)
+	{
+		if (!ret.empty())
+			ret += ';';
+
+		SourceLocation const& location = item.location();
+		int length = location.start != -1 && location.end != -1 ? location.end - location.start : -1;
+		int sourceIndex = prevSourceIndex;
+		if (!location.source)
+			sourceIndex = -1;
+		else if (location.source.get() != prevSource)
+		{
+			auto cached = sourceIndexCache.find(location.source.get());
+			if (cached == sourceIndexCache.end())
+			{
+				auto index = _sourceIndices.find(location.source->name());
+				sourceIndex = index == _sourceIndices.end() ? -1 : int(index->second);
+				sourceIndexCache[location.source.get()] = sourceIndex;
+			}
+			else
+				sourceIndex = cached->second;
+		}
+		prevSource = location.source.get();
+		char jump = '-';
+		if (item.getJumpType() == AssemblyItem::JumpType::IntoFunction)
+			jump = 'i';
+		else if (item.getJumpType() == AssemblyItem::JumpType::OutOfFunction)
+			jump = 'o';
+
+		unsigned components = 4;
+		if (jump == prevJump)
+		{
+			components--;
+			if (sourceIndex == prevSourceIndex)
+			{
+				components--;
+				if (length == prevLength)
+				{
+					components--;
+					if (location.start == prevStart)
+						components--;
+				}
+			}
+		}
+
+		if (components-- > 0)
+		{
+			if (location.start != prevStart)
+				appendNumber(ret, location.start);
+			if (components-- > 0)
+			{
+				ret += ':';
+				if (length != prevLength)
+					appendNumber(ret, length);
+				if (components-- > 0)
+				{
+					ret += ':';
+					if (sourceIndex != prevSourceIndex)
+						appendNumber(ret, sourceIndex);
+					if (components-- > 0)
+					{
+						ret += ':';
+						if (jump != prevJump)
+							ret += jump;
+					}
+				}
+			}
+		}
+
+		prevStart = location.start;
+		prevLength = length;
+		prevSourceIndex = sourceIndex;
+		prevJump = jump;
+	}
+	return ret;
+}
+
 ostream& dev::eth::operator<<(ostream& _out, AssemblyItem const& _item)
 {
 	switch (_item.type())
@@ -167,6 +167,10 @@ inline size_t bytesRequired(AssemblyItems const& _items, size_t _addressLength)
 	return size;
 }
 
+/// @returns the compressed source mapping of @a _items. The sources of the locations are
+/// referenced by the index @a _sourceIndices assigns to their name or by -1 if it has none.
+std::string computeSourceMapping(AssemblyItems const& _items, std::map<std::string, unsigned> const& _sourceIndices);
+
 std::ostream& operator<<(std::ostream& _out, AssemblyItem const& _item);
 inline std::ostream& operator<<(std::ostream& _out, AssemblyItems const& _items)
 {
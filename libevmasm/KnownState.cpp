@@ -248,8 +248,12 @@ ExpressionClasses::Id KnownState::stackElement(int _stackHeight, SourceLocation
 	if (m_stackElements.count(_stackHeight))
 		return m_stackElements.at(_stackHeight);
 	// Stack element not found (not assigned yet), create new unknown equivalence class.
+	// Outside of region zero, its data contains the region, below the range of ExpressionClasses::newClass.
+	u256 data = _stackHeight;
+	if (m_stackRegion)
+		data = (u256(1) << 254) + (u256(m_stackRegion) << 64) + u256(uint32_t(_stackHeight));
 	return m_stackElements[_stackHeight] =
-			m_expressionClasses->find(AssemblyItem(UndefinedItem, _stackHeight, _location));
+			m_expressionClasses->find(AssemblyItem(UndefinedItem, data, _location));
 }
 
 KnownState::Id KnownState::relativeStackElement(int _stackOffset, SourceLocation const& _location)
@@ -104,6 +104,10 @@ public:
 	void resetStack() { m_stackElements.clear(); m_stackHeight = 0; }
 	/// Resets any knowledge.
 	void reset() { resetStorage(); resetMemory(); resetStack(); }
+	/// Makes the classes of stack elements that are not known yet unique to @a _region.
+	/// Used when several states share their expression classes, so that unknown stack elements
+	/// at the starts of different regions of code are never considered equal.
+	void setStackRegion(unsigned _region) { m_stackRegion = _region; }
 
 	unsigned sequenceNumber() const { return m_sequenceNumber; }
 
@@ -137,6 +141,7 @@ public:
 	ExpressionClasses& expressionClasses() const { return *m_expressionClasses; }
 
 	std::map<Id, Id> const& storageContent() const { return m_storageContent; }
+	std::map<Id, Id> const& memoryContent() const { return m_memoryContent; }
 
 private:
 	/// Assigns a new equivalence class to the next sequence number of the given stack element.
@@ -166,6 +171,8 @@ private:
 	int m_stackHeight = 0;
 	/// Current stack layout, mapping stack height -> equivalence class
 	std::map<int, Id> m_stackElements;
+	/// Region of code that unknown stack elements belong to, see setStackRegion.
+	unsigned m_stackRegion = 0;
 	/// Current sequence number, this is incremented with each modification to storage or memory.
 	unsigned m_sequenceNumber = 1;
 	/// Knowledge about storage content.
@@ -34,11 +34,57 @@ void LinkerObject::append(LinkerObject const& _other)
 	bytecode += _other.bytecode;
 }
 
+LinkerObject::Libraries::Libraries(map<string, h160> const& _libraryAddresses)
+{
+	for (auto const& library: _libraryAddresses)
+	{
+		string const& name = library.first;
+		m_byName[name] = library.second;
+		// Library placeholders are 40 hex digits (20 bytes) that start and end with '__'.
+		// This leaves 36 characters for the library identifier. The identifier used to
+		// be just the cropped or '_'-padded library name, but this changed to
+		// the cropped hex representation of the hash of the library name.
+		// We support both ways of linking here.
+		m_byPlaceholder[libraryPlaceholder(name)] = library.second;
+		string legacyPlaceholder = name.substr(0, 36);
+		legacyPlaceholder.resize(36, '_');
+		m_byPlaceholder[legacyPlaceholder] = library.second;
+	}
+}
+
+h160 const* LinkerObject::Libraries::find(string const& _linkRefName) const
+{
+	auto it = m_byName.find(_linkRefName);
+	if (it != m_byName.end())
+		return &it->second;
+	// If the user did not supply a fully qualified library name,
+	// try to match only the simple library name
+	size_t colon = _linkRefName.find(':');
+	if (colon == string::npos)
+		return nullptr;
+	it = m_byName.find(_linkRefName.substr(colon + 1));
+	if (it != m_byName.end())
+		return &it->second;
+	return nullptr;
+}
+
+h160 const* LinkerObject::Libraries::findPlaceholder(string const& _placeholder) const
+{
+	auto it = m_byPlaceholder.find(_placeholder);
+	return it == m_byPlaceholder.end() ? nullptr : &it->second;
+}
+
 void LinkerObject::link(map<string, h160> const& _libraryAddresses)
+{
+	if (!linkReferences.empty())
+		link(Libraries(_libraryAddresses));
+}
+
+void LinkerObject::link(Libraries const& _libraries)
 {
 	std::map<size_t, std::string> remainingRefs;
 	for (auto const& linkRef: linkReferences)
-		if (h160 const* address = matchLibrary(linkRef.second, _libraryAddresses))
+		if (h160 const* address = _libraries.find(linkRef.second))
 			copy(address->data(), address->data() + 20, bytecode.begin() + linkRef.first);
 		else
 			remainingRefs.insert(linkRef);
@@ -64,22 +110,31 @@ string LinkerObject::libraryPlaceholder(string const& _libraryName)
 	return "$" + keccak256(_libraryName).hex().substr(0, 34) + "$";
 }
 
-h160 const*
-LinkerObject::matchLibrary(
-	string const& _linkRefName,
-	map<string, h160> const& _libraryAddresses
-)
+bool LinkerObject::linkHex(string& _hex, Libraries const& _libraries, vector<string>& _unresolved)
 {
-	auto it = _libraryAddresses.find(_linkRefName);
-	if (it != _libraryAddresses.end())
-		return &it->second;
-	// If the user did not supply a fully qualified library name,
-	// try to match only the simple library name
-	size_t colon = _linkRefName.find(':');
-	if (colon == string::npos)
-		return nullptr;
-	it = _libraryAddresses.find(_linkRefName.substr(colon + 1));
-	if (it != _libraryAddresses.end())
-		return &it->second;
-	return nullptr;
+	size_t const placeholderSize = 40; // 20 bytes or 40 hex characters
+	static char const hexDigits[] = "0123456789abcdef";
+	// Reused for all lookups, so that only the first one allocates.
+	string placeholder;
+	// Searching for the character uses memchr, which is vectorised.
+	for (size_t pos = _hex.find('_'); pos != string::npos; pos = _hex.find('_', pos))
+	{
+		if (_hex.size() - pos < placeholderSize)
+			return false;
+
+		placeholder.assign(_hex, pos + 2, placeholderSize - 4);
+		h160 const* address = nullptr;
+		if (_hex[pos + 1] == '_' && _hex[pos + placeholderSize - 2] == '_' && _hex[pos + placeholderSize - 1] == '_')
+			address = _libraries.findPlaceholder(placeholder);
+		if (address)
+			for (size_t i = 0; i < 20; ++i)
+			{
+				_hex[pos + 2 * i] = hexDigits[(*address)[i] >> 4];
+				_hex[pos + 2 * i + 1] = hexDigits[(*address)[i] & 0xf];
+			}
+		else
+			_unresolved.emplace_back(_hex, pos, placeholderSize);
+		pos += placeholderSize;
+	}
+	return true;
 }
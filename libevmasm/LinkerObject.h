@@ -24,6 +24,8 @@
 #include <libdevcore/Common.h>
 #include <libdevcore/FixedHash.h>
 
+#include <unordered_map>
+
 namespace dev
 {
 namespace eth
@@ -35,6 +37,26 @@ namespace eth
  */
 struct LinkerObject
 {
+	/// Library addresses indexed for linking, by the names used in link references and by the
+	/// placeholders used in hex code. Building it once allows linking many objects with it.
+	class Libraries
+	{
+	public:
+		explicit Libraries(std::map<std::string, h160> const& _libraryAddresses);
+
+		/// @returns the address of the library referenced by @a _linkRefName or nullptr.
+		/// If no library with the fully qualified name was supplied, the simple name is tried.
+		h160 const* find(std::string const& _linkRefName) const;
+		/// @returns the address of the library whose placeholder has the 36 characters between
+		/// the enclosing `__` given by @a _placeholder or nullptr.
+		h160 const* findPlaceholder(std::string const& _placeholder) const;
+
+	private:
+		std::unordered_map<std::string, h160> m_byName;
+		/// Addresses by placeholder, both in the hashed and in the legacy, name-based form.
+		std::unordered_map<std::string, h160> m_byPlaceholder;
+	};
+
 	bytes bytecode;
 	/// Map from offsets in bytecode to library identifiers. The addresses starting at those offsets
 	/// need to be replaced by the actual addresses by the linker.
@@ -45,6 +67,7 @@ struct LinkerObject
 
 	/// Links the given libraries by replacing their uses in the code and removes them from the references.
 	void link(std::map<std::string, h160> const& _libraryAddresses);
+	void link(Libraries const& _libraries);
 
 	/// @returns a hex representation of the bytecode of the given object, replacing unlinked
 	/// addresses by placeholders.
@@ -55,11 +78,11 @@ struct LinkerObject
 	/// of the first 18 bytes of the keccak-256 hash of @a _libraryName.
 	static std::string libraryPlaceholder(std::string const& _libraryName);
 
-private:
-	static h160 const* matchLibrary(
-		std::string const& _linkRefName,
-		std::map<std::string, h160> const& _libraryAddresses
-	);
+	/// Replaces the library placeholders in the hex code @a _hex by the addresses of the libraries
+	/// and appends the placeholders (including the enclosing `__`) that could not be resolved
+	/// to @a _unresolved.
+	/// @returns false if @a _hex ends in a truncated placeholder.
+	static bool linkHex(std::string& _hex, Libraries const& _libraries, std::vector<std::string>& _unresolved);
 };
 
 }
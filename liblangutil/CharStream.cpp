@@ -53,9 +53,118 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 using namespace std;
 using namespace langutil;
 
+namespace
+{
+
+// Character classes for the bulk scanning helpers. Each one tests a single character
+// and, if SSE2 is available, computes a byte mask for 16 characters at once.
+
+struct NonWhitespace
+{
+	bool operator()(uint8_t _c) const { return !(_c == ' ' || _c == '\n' || _c == '\t' || _c == '\r'); }
+#if defined(__SSE2__)
+	__m128i operator()(__m128i _chars) const
+	{
+		__m128i whitespace = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(_chars, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(_chars, _mm_set1_epi8('\n'))),
+			_mm_or_si128(_mm_cmpeq_epi8(_chars, _mm_set1_epi8('\t')), _mm_cmpeq_epi8(_chars, _mm_set1_epi8('\r')))
+		);
+		return _mm_xor_si128(whitespace, _mm_set1_epi8(char(0xff)));
+	}
+#endif
+};
+
+struct LinebreakCandidate
+{
+	bool operator()(uint8_t _c) const { return (0x0a <= _c && _c <= 0x0d) || _c == 0xc2 || _c == 0xe2; }
+#if defined(__SSE2__)
+	__m128i operator()(__m128i _chars) const
+	{
+		// Unsigned range check for 0x0a - 0x0d via min(x - 0x0a, 3) == x - 0x0a.
+		__m128i offset = _mm_sub_epi8(_chars, _mm_set1_epi8(0x0a));
+		__m128i controls = _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(3)), offset);
+		__m128i leadBytes = _mm_or_si128(
+			_mm_cmpeq_epi8(_chars, _mm_set1_epi8(char(0xc2))),
+			_mm_cmpeq_epi8(_chars, _mm_set1_epi8(char(0xe2)))
+		);
+		return _mm_or_si128(controls, leadBytes);
+	}
+#endif
+};
+
+struct Character
+{
+	char c;
+	bool operator()(uint8_t _c) const { return _c == uint8_t(c); }
+#if defined(__SSE2__)
+	__m128i operator()(__m128i _chars) const { return _mm_cmpeq_epi8(_chars, _mm_set1_epi8(c)); }
+#endif
+};
+
+struct StringLiteralSpecial
+{
+	char quote;
+	bool operator()(uint8_t _c) const { return _c == uint8_t(quote) || _c == '\\' || LinebreakCandidate{}(_c); }
+#if defined(__SSE2__)
+	__m128i operator()(__m128i _chars) const
+	{
+		return _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(_chars, _mm_set1_epi8(quote)), _mm_cmpeq_epi8(_chars, _mm_set1_epi8('\\'))),
+			LinebreakCandidate{}(_chars)
+		);
+	}
+#endif
+};
+
+/// @returns the distance from @a _position to the first character in @a _text
+/// that belongs to the class @a _stop, or to the end of @a _text.
+template <class CharacterClass>
+size_t distanceToFirst(string const& _text, size_t _position, CharacterClass _stop)
+{
+	size_t i = _position;
+#if defined(__SSE2__)
+	for (; i + 16 <= _text.size(); i += 16)
+	{
+		__m128i chars = _mm_loadu_si128(reinterpret_cast<__m128i const*>(_text.data() + i));
+		if (int mask = _mm_movemask_epi8(_stop(chars)))
+			return i + size_t(__builtin_ctz(unsigned(mask))) - _position;
+	}
+#endif
+	for (; i < _text.size(); ++i)
+		if (_stop(uint8_t(_text[i])))
+			break;
+	return i - _position;
+}
+
+}
+
+size_t CharStream::distanceToNonWhitespace() const
+{
+	return distanceToFirst(*m_source, m_position, NonWhitespace{});
+}
+
+size_t CharStream::distanceToLinebreakCandidate() const
+{
+	return distanceToFirst(*m_source, m_position, LinebreakCandidate{});
+}
+
+size_t CharStream::distanceTo(char _c) const
+{
+	return distanceToFirst(*m_source, m_position, Character{_c});
+}
+
+size_t CharStream::distanceToStringLiteralSpecial(char _quote) const
+{
+	return distanceToFirst(*m_source, m_position, StringLiteralSpecial{_quote});
+}
+
 char CharStream::advanceAndGet(size_t _chars)
 {
 	if (isPastEndOfInput())
@@ -63,7 +172,7 @@ char CharStream::advanceAndGet(size_t _chars)
 	m_position += _chars;
 	if (isPastEndOfInput())
 		return 0;
-	return m_source[m_position];
+	return (*m_source)[m_position];
 }
 
 char CharStream::rollback(size_t _amount)
@@ -77,31 +186,33 @@ string CharStream::lineAtPosition(int _position) const
 {
 	// if _position points to \n, it returns the line before the \n
 	using size_type = string::size_type;
-	size_type searchStart = min<size_type>(m_source.size(), _position);
+	string const& source = *m_source;
+	size_type searchStart = min<size_type>(source.size(), _position);
 	if (searchStart > 0)
 		searchStart--;
-	size_type lineStart = m_source.rfind('\n', searchStart);
+	size_type lineStart = source.rfind('\n', searchStart);
 	if (lineStart == string::npos)
 		lineStart = 0;
 	else
 		lineStart++;
-	return m_source.substr(
+	return source.substr(
 		lineStart,
-		min(m_source.find('\n', lineStart), m_source.size()) - lineStart
+		min(source.find('\n', lineStart), source.size()) - lineStart
 	);
 }
 
 tuple<int, int> CharStream::translatePositionToLineColumn(int _position) const
 {
 	using size_type = string::size_type;
-	size_type searchPosition = min<size_type>(m_source.size(), _position);
-	int lineNumber = count(m_source.begin(), m_source.begin() + searchPosition, '\n');
+	string const& source = *m_source;
+	size_type searchPosition = min<size_type>(source.size(), _position);
+	int lineNumber = count(source.begin(), source.begin() + searchPosition, '\n');
 	size_type lineStart;
 	if (searchPosition == 0)
 		lineStart = 0;
 	else
 	{
-		lineStart = m_source.rfind('\n', searchPosition - 1);
+		lineStart = source.rfind('\n', searchPosition - 1);
 		lineStart = lineStart == string::npos ? 0 : lineStart + 1;
 	}
 	return tuple<int, int>(lineNumber, searchPosition - lineStart);
@@ -53,6 +53,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <tuple>
 
@@ -63,24 +64,44 @@ namespace langutil
  * Bidirectional stream of characters.
  *
  * This CharStream is used by lexical analyzers as the source.
+ * The source text is immutable and shared between copies of the stream, so it can also
+ * be shared with the owner of the text, which avoids holding large sources several times.
  */
 class CharStream
 {
 public:
-	CharStream() = default;
-	explicit CharStream(std::string const& _source, std::string const& name):
-		m_source(_source), m_name(name) {}
+	CharStream(): m_source(std::make_shared<std::string const>()) {}
+	explicit CharStream(std::string _source, std::string name):
+		m_source(std::make_shared<std::string const>(std::move(_source))), m_name(std::move(name)) {}
+	/// Creates a stream that only views the shared buffer @a _source.
+	explicit CharStream(std::shared_ptr<std::string const> _source, std::string name):
+		m_source(std::move(_source)), m_name(std::move(name)) {}
 
 	int position() const { return m_position; }
-	bool isPastEndOfInput(size_t _charsForward = 0) const { return (m_position + _charsForward) >= m_source.size(); }
+	bool isPastEndOfInput(size_t _charsForward = 0) const { return (m_position + _charsForward) >= m_source->size(); }
 
-	char get(size_t _charsForward = 0) const { return m_source[m_position + _charsForward]; }
+	char get(size_t _charsForward = 0) const { return (*m_source)[m_position + _charsForward]; }
 	char advanceAndGet(size_t _chars = 1);
 	char rollback(size_t _amount);
 
 	void reset() { m_position = 0; }
 
-	std::string const& source() const noexcept { return m_source; }
+	///@{
+	///@name Bulk scanning helpers
+	/// Each of these @returns the number of characters from the current position up to the
+	/// first character of the given kind, or up to the end of input. They test 16 characters
+	/// at once where SSE2 is available.
+	/// Stops at the first character that is not a space, tab, line feed or carriage return.
+	size_t distanceToNonWhitespace() const;
+	/// Stops at 0x0a - 0x0d and at the lead bytes of the multi-byte unicode line breaks.
+	size_t distanceToLinebreakCandidate() const;
+	/// Stops at @a _c.
+	size_t distanceTo(char _c) const;
+	/// Stops at @a _quote, at a backslash and wherever distanceToLinebreakCandidate stops.
+	size_t distanceToStringLiteralSpecial(char _quote) const;
+	///@}
+
+	std::string const& source() const noexcept { return *m_source; }
 	std::string const& name() const noexcept { return m_name; }
 
 	///@{
@@ -92,7 +113,7 @@ public:
 	///@}
 
 private:
-	std::string m_source;
+	std::shared_ptr<std::string const> m_source;
 	std::string m_name;
 	size_t m_position{0};
 };
@@ -50,6 +50,11 @@ public:
 		m_errorList += _errorList;
 	}
 
+	/// Appends errors and warnings that were reported to a different list, e.g. by a
+	/// check that ran with its own reporter, as if they had been reported here. They are counted
+	/// towards the limits on the number of errors and warnings.
+	void merge(ErrorList const& _errorList);
+
 	void warning(std::string const& _description);
 
 	void warning(SourceLocation const& _location, std::string const& _description);
@@ -227,11 +227,13 @@ Token Scanner::selectToken(char _next, Token _then, Token _else)
 
 bool Scanner::skipWhitespace()
 {
-	int const startPosition = sourcePos();
-	while (isWhiteSpace(m_char))
-		advance();
-	// Return whether or not we skipped any characters.
-	return sourcePos() != startPosition;
+	if (!isWhiteSpace(m_char))
+		return false;
+	// m_char need not be the character at the current position, skipMultiLineComment
+	// replaces the closing slash by a space, so always advance past it first.
+	advance();
+	m_char = m_source->advanceAndGet(m_source->distanceToNonWhitespace());
+	return true;
 }
 
 void Scanner::skipWhitespaceExceptUnicodeLinebreak()
@@ -244,8 +246,13 @@ Token Scanner::skipSingleLineComment()
 {
 	// Line terminator is not part of the comment. If it is a
 	// non-ascii line terminator, it will result in a parser error.
-	while (!isUnicodeLinebreak())
-		if (!advance()) break;
+	while (true)
+	{
+		m_char = m_source->advanceAndGet(m_source->distanceToLinebreakCandidate());
+		if (isSourcePastEndOfInput() || isUnicodeLinebreak())
+			break;
+		advance();
+	}
 
 	return Token::Whitespace;
 }
@@ -291,13 +298,15 @@ Token Scanner::skipMultiLineComment()
 	advance();
 	while (!isSourcePastEndOfInput())
 	{
-		char ch = m_char;
+		m_char = m_source->advanceAndGet(m_source->distanceTo('*'));
+		if (isSourcePastEndOfInput())
+			break;
 		advance();
 
 		// If we have reached the end of the multi-line comment, we
 		// consume the '/' and insert a whitespace. This way all
 		// multi-line comments are treated as whitespace.
-		if (ch == '*' && m_char == '/')
+		if (m_char == '/')
 		{
 			m_char = ' ';
 			return Token::Whitespace;
@@ -705,8 +714,14 @@ Token Scanner::scanString()
 	char const quote = m_char;
 	advance();  // consume quote
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
-	while (m_char != quote && !isSourcePastEndOfInput() && !isUnicodeLinebreak())
+	while (true)
 	{
+		// Copy the run of characters that need no special treatment at once.
+		size_t const run = m_source->distanceToStringLiteralSpecial(quote);
+		m_nextToken.literal.append(m_source->source(), size_t(m_source->position()), run);
+		m_char = m_source->advanceAndGet(run);
+		if (m_char == quote || isSourcePastEndOfInput() || isUnicodeLinebreak())
+			break;
 		char c = m_char;
 		advance();
 		if (c == '\\')
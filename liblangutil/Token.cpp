@@ -41,8 +41,12 @@
 // along with solidity.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <liblangutil/Token.h>
-#include <boost/range/iterator_range.hpp>
-#include <map>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <utility>
+#include <vector>
 
 using namespace std;
 
@@ -124,49 +128,114 @@ int precedence(Token tok)
 }
 #undef T
 
-int parseSize(string::const_iterator _begin, string::const_iterator _end)
+namespace
 {
-	try
-	{
-		unsigned int m = boost::lexical_cast<int>(boost::make_iterator_range(_begin, _end));
-		return m;
-	}
-	catch(boost::bad_lexical_cast const&)
-	{
+
+/// @returns the decimal value of the digits in [_begin, _end) or -1 if the range
+/// is empty or the value does not fit into an int.
+int parseSize(char const* _begin, char const* _end)
+{
+	if (_begin == _end)
 		return -1;
+	long long m = 0;
+	for (char const* it = _begin; it != _end; ++it)
+	{
+		m = m * 10 + (*it - '0');
+		if (m > numeric_limits<int>::max())
+			return -1;
 	}
+	return int(m);
 }
 
-static Token keywordByName(string const& _name)
+/// Collision-free hash table over all keywords. The seed of the hash function is chosen
+/// when the table is built so that no two keywords share a slot, so a lookup needs one
+/// hash computation and at most one string comparison.
+class KeywordTable
 {
-	// The following macros are used inside TOKEN_LIST and cause non-keyword tokens to be ignored
-	// and keywords to be put inside the keywords variable.
+public:
+	KeywordTable()
+	{
+		// The following macros are used inside TOKEN_LIST and cause non-keyword tokens to be ignored
+		// and keywords to be put inside the keywords variable.
 #define KEYWORD(name, string, precedence) {string, Token::name},
 #define TOKEN(name, string, precedence)
-	static map<string, Token> const keywords({TOKEN_LIST(TOKEN, KEYWORD)});
+		m_keywords = {TOKEN_LIST(TOKEN, KEYWORD)};
 #undef KEYWORD
 #undef TOKEN
-	auto it = keywords.find(_name);
-	return it == keywords.end() ? Token::Identifier : it->second;
+		solAssert(m_keywords.size() < c_empty, "Too many keywords.");
+
+		for (m_seed = 0; !tryBuild(); ++m_seed)
+			solAssert(m_seed < 0x10000, "No perfect hash found for the keywords.");
+	}
+
+	Token find(char const* _begin, size_t _length) const
+	{
+		uint8_t index = m_slots[slot(_begin, _length)];
+		if (index == c_empty)
+			return Token::Identifier;
+		auto const& keyword = m_keywords[index];
+		if (keyword.first.size() != _length || keyword.first.compare(0, _length, _begin, _length) != 0)
+			return Token::Identifier;
+		return keyword.second;
+	}
+
+private:
+	static size_t const c_slots = 2048;
+	static uint8_t const c_empty = 0xff;
+
+	size_t slot(char const* _begin, size_t _length) const
+	{
+		// FNV-1a
+		uint32_t hash = 2166136261u ^ m_seed;
+		for (size_t i = 0; i < _length; ++i)
+			hash = (hash ^ uint8_t(_begin[i])) * 16777619u;
+		return (hash ^ (hash >> 16) ^ uint32_t(_length)) & (c_slots - 1);
+	}
+
+	bool tryBuild()
+	{
+		m_slots.fill(c_empty);
+		for (size_t i = 0; i < m_keywords.size(); ++i)
+		{
+			uint8_t& entry = m_slots[slot(m_keywords[i].first.data(), m_keywords[i].first.size())];
+			if (entry != c_empty)
+				return false;
+			entry = uint8_t(i);
+		}
+		return true;
+	}
+
+	vector<pair<string, Token>> m_keywords;
+	array<uint8_t, c_slots> m_slots;
+	uint32_t m_seed = 0;
+};
+
+Token keywordByName(char const* _begin, size_t _length)
+{
+	static KeywordTable const keywords;
+	return keywords.find(_begin, _length);
+}
+
 }
 
 tuple<Token, unsigned int, unsigned int> fromIdentifierOrKeyword(string const& _literal)
 {
-	auto positionM = find_if(_literal.begin(), _literal.end(), ::isdigit);
-	if (positionM != _literal.end())
+	char const* begin = _literal.data();
+	char const* end = begin + _literal.size();
+	char const* positionM = find_if(begin, end, ::isdigit);
+	if (positionM != end)
 	{
-		string baseType(_literal.begin(), positionM);
-		auto positionX = find_if_not(positionM, _literal.end(), ::isdigit);
+		char const* positionX = find_if_not(positionM, end, ::isdigit);
 		int m = parseSize(positionM, positionX);
-		Token keyword = keywordByName(baseType);
+		Token keyword = keywordByName(begin, positionM - begin);
 		if (keyword == Token::Bytes)
 		{
-			if (0 < m && m <= 32 && positionX == _literal.end())
+			if (0 < m && m <= 32 && positionX == end)
 				return make_tuple(Token::BytesM, m, 0);
 		}
 		else if (keyword == Token::UInt || keyword == Token::Int)
 		{
-			if (0 < m && m <= 256 && m % 8 == 0 && positionX == _literal.end())
+			if (0 < m && m <= 256 && m % 8 == 0 && positionX == end)
 			{
 				if (keyword == Token::UInt)
 					return make_tuple(Token::UIntM, m, 0);
@@ -178,11 +247,11 @@ tuple<Token, unsigned int, unsigned int> fromIdentifierOrKeyword(string const& _
 		{
 			if (
 				positionM < positionX &&
-				positionX < _literal.end() &&
+				positionX < end &&
 				*positionX == 'x' &&
-				all_of(positionX + 1, _literal.end(), ::isdigit)
+				all_of(positionX + 1, end, ::isdigit)
 			) {
-				int n = parseSize(positionX + 1, _literal.end());
+				int n = parseSize(positionX + 1, end);
 				if (
 					8 <= m && m <= 256 && m % 8 == 0 &&
 					0 <= n && n <= 80
@@ -197,7 +266,7 @@ tuple<Token, unsigned int, unsigned int> fromIdentifierOrKeyword(string const& _
 		return make_tuple(Token::Identifier, 0, 0);
 	}
 
-	return make_tuple(keywordByName(_literal), 0, 0);
+	return make_tuple(keywordByName(begin, _literal.size()), 0, 0);
 }
 
 }
@@ -26,10 +26,22 @@
 #include <libsolidity/ast/Types.h>
 #include <libdevcore/StringUtils.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace dev;
 using namespace dev::solidity;
 
+map<ASTString, vector<Declaration const*>> const& DeclarationContainer::declarations() const
+{
+	if (m_sortedDeclarationsGeneration != m_generation)
+	{
+		m_sortedDeclarations = map<ASTString, vector<Declaration const*>>(m_declarations.begin(), m_declarations.end());
+		m_sortedDeclarationsGeneration = m_generation;
+	}
+	return m_sortedDeclarations;
+}
+
 Declaration const* DeclarationContainer::conflictingDeclaration(
 	Declaration const& _declaration,
 	ASTString const* _name
@@ -89,6 +101,8 @@ void DeclarationContainer::activateVariable(ASTString const& _name)
 	solAssert(m_declarations.count(_name) == 0 || m_declarations.at(_name).empty(), "");
 	m_declarations[_name].emplace_back(m_invisibleDeclarations.at(_name).front());
 	m_invisibleDeclarations.erase(_name);
+	++m_generation;
+	++*m_treeChanges;
 }
 
 bool DeclarationContainer::isInvisible(ASTString const& _name) const
@@ -120,6 +134,8 @@ bool DeclarationContainer::registerDeclaration(
 	vector<Declaration const*>& decls = _invisible ? m_invisibleDeclarations[*_name] : m_declarations[*_name];
 	if (!contains(decls, &_declaration))
 		decls.push_back(&_declaration);
+	++m_generation;
+	++*m_treeChanges;
 	return true;
 }
 
@@ -127,15 +143,38 @@ vector<Declaration const*> DeclarationContainer::resolveName(ASTString const& _n
 {
 	solAssert(!_name.empty(), "Attempt to resolve empty name.");
 	vector<Declaration const*> result;
-	if (m_declarations.count(_name))
-		result = m_declarations.at(_name);
-	if (_alsoInvisible && m_invisibleDeclarations.count(_name))
-		result += m_invisibleDeclarations.at(_name);
+	auto declarations = m_declarations.find(_name);
+	if (declarations != m_declarations.end())
+		result = declarations->second;
+	if (_alsoInvisible)
+	{
+		auto invisibleDeclarations = m_invisibleDeclarations.find(_name);
+		if (invisibleDeclarations != m_invisibleDeclarations.end())
+			result += invisibleDeclarations->second;
+	}
 	if (result.empty() && _recursive && m_enclosingContainer)
+	{
+		size_t const generation = chainGeneration();
+		auto& cache = m_lookupCache[_alsoInvisible ? 1 : 0];
+		auto cached = cache.find(_name);
+		if (cached != cache.end() && cached->second.generation == generation)
+			return cached->second.declarations;
 		result = m_enclosingContainer->resolveName(_name, true, _alsoInvisible);
+		cache[_name] = CachedLookup{generation, result};
+	}
 	return result;
 }
 
+size_t DeclarationContainer::chainGeneration() const
+{
+	if (m_chainGenerationTreeChanges != *m_treeChanges)
+	{
+		m_chainGeneration = m_generation + (m_enclosingContainer ? m_enclosingContainer->chainGeneration() : 0);
+		m_chainGenerationTreeChanges = *m_treeChanges;
+	}
+	return m_chainGeneration;
+}
+
 vector<ASTString> DeclarationContainer::similarNames(ASTString const& _name) const
 {
 
@@ -145,17 +184,18 @@ vector<ASTString> DeclarationContainer::similarNames(ASTString const& _name) con
 
 	vector<ASTString> similar;
 	size_t maximumEditDistance = _name.size() > 3 ? 2 : _name.size() / 2;
-	for (auto const& declaration: m_declarations)
+	// The tables are unordered, so sort the matches of each one to keep suggestions deterministic.
+	for (auto const* table: {&m_declarations, &m_invisibleDeclarations})
 	{
-		string const& declarationName = declaration.first;
-		if (stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
-			similar.push_back(declarationName);
-	}
-	for (auto const& declaration: m_invisibleDeclarations)
-	{
-		string const& declarationName = declaration.first;
-		if (stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
-			similar.push_back(declarationName);
+		vector<ASTString> matches;
+		for (auto const& declaration: *table)
+		{
+			string const& declarationName = declaration.first;
+			if (stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
+				matches.push_back(declarationName);
+		}
+		sort(matches.begin(), matches.end());
+		similar += matches;
 	}
 
 	if (m_enclosingContainer)
@@ -24,8 +24,11 @@
 
 #include <libsolidity/ast/ASTForward.h>
 #include <boost/noncopyable.hpp>
+#include <array>
 #include <map>
 #include <set>
+#include <memory>
+#include <unordered_map>
 
 namespace dev
 {
@@ -35,6 +38,10 @@ namespace solidity
 /**
  * Container that stores mappings between names and declarations. It also contains a link to the
  * enclosing scope.
+ * Names are kept in hash tables and recursive lookups are memoised per container. The memo is
+ * invalidated whenever the container or one of its enclosing containers registers or activates
+ * a declaration. Containers created from a common root share a change counter, so checking
+ * the memo does not have to walk the enclosing chain as long as nothing changed.
  */
 class DeclarationContainer
 {
@@ -43,7 +50,10 @@ public:
 		ASTNode const* _enclosingNode = nullptr,
 		DeclarationContainer const* _enclosingContainer = nullptr
 	):
-		m_enclosingNode(_enclosingNode), m_enclosingContainer(_enclosingContainer) {}
+		m_enclosingNode(_enclosingNode),
+		m_enclosingContainer(_enclosingContainer),
+		m_treeChanges(_enclosingContainer ? _enclosingContainer->m_treeChanges : std::make_shared<size_t>(0))
+	{}
 	/// Registers the declaration in the scope unless its name is already declared or the name is empty.
 	/// @param _name the name to register, if nullptr the intrinsic name of @a _declaration is used.
 	/// @param _invisible if true, registers the declaration, reports name clashes but does not return it in @a resolveName
@@ -53,7 +63,9 @@ public:
 	std::vector<Declaration const*> resolveName(ASTString const& _name, bool _recursive = false, bool _alsoInvisible = false) const;
 	ASTNode const* enclosingNode() const { return m_enclosingNode; }
 	DeclarationContainer const* enclosingContainer() const { return m_enclosingContainer; }
-	std::map<ASTString, std::vector<Declaration const*>> const& declarations() const { return m_declarations; }
+	/// @returns the visible declarations ordered by name. The reference stays valid until
+	/// the next call after the container changed.
+	std::map<ASTString, std::vector<Declaration const*>> const& declarations() const;
 	/// @returns whether declaration is valid, and if not also returns previous declaration.
 	Declaration const* conflictingDeclaration(Declaration const& _declaration, ASTString const* _name = nullptr) const;
 
@@ -69,10 +81,33 @@ public:
 	std::vector<ASTString> similarNames(ASTString const& _name) const;
 
 private:
+	struct CachedLookup
+	{
+		size_t generation;
+		std::vector<Declaration const*> declarations;
+	};
+
+	/// @returns the sum of the generations of this and all enclosing containers. Generations
+	/// only grow, so it changes whenever one of the containers changes. The sum is recomputed
+	/// only if some container of the tree changed since the last call.
+	size_t chainGeneration() const;
+
 	ASTNode const* m_enclosingNode;
 	DeclarationContainer const* m_enclosingContainer;
-	std::map<ASTString, std::vector<Declaration const*>> m_declarations;
-	std::map<ASTString, std::vector<Declaration const*>> m_invisibleDeclarations;
+	std::unordered_map<ASTString, std::vector<Declaration const*>> m_declarations;
+	std::unordered_map<ASTString, std::vector<Declaration const*>> m_invisibleDeclarations;
+	/// Incremented whenever a declaration is registered or activated.
+	size_t m_generation = 0;
+	/// Number of changes in all containers sharing the root of this one.
+	std::shared_ptr<size_t> m_treeChanges;
+	/// Last result of chainGeneration() and the value of m_treeChanges it was computed at.
+	mutable size_t m_chainGeneration = 0;
+	mutable size_t m_chainGenerationTreeChanges = size_t(-1);
+	/// Results of recursive lookups, indexed by whether invisible declarations were included.
+	mutable std::array<std::unordered_map<ASTString, CachedLookup>, 2> m_lookupCache;
+	/// Ordered copy of m_declarations and the generation it was built at.
+	mutable std::map<ASTString, std::vector<Declaration const*>> m_sortedDeclarations;
+	mutable size_t m_sortedDeclarationsGeneration = size_t(-1);
 };
 
 }
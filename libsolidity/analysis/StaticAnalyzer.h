@@ -47,7 +47,7 @@ class ConstructorUsesAssembly;
  * programmers write cleaner code. For every warning generated here, it has to be possible to write
  * equivalent code that does not generate the warning.
  */
-class StaticAnalyzer: private ASTConstVisitor
+class StaticAnalyzer: public ASTConstVisitor
 {
 public:
 	/// @param _errorReporter provides the error logging functionality.
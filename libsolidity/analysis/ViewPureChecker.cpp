@@ -123,24 +123,32 @@ private:
 
 bool ViewPureChecker::check()
 {
-	vector<ContractDefinition const*> contracts;
+	// Check modifiers first to infer their state mutability.
+	inferModifierMutability();
+
+	for (auto const& contract: contracts())
+		contract->accept(*this);
+
+	return !m_errors;
+}
+
+void ViewPureChecker::inferModifierMutability()
+{
+	for (auto const& contract: contracts())
+		for (ModifierDefinition const* mod: contract->functionModifiers())
+			mod->accept(*this);
+}
 
+vector<ContractDefinition const*> ViewPureChecker::contracts() const
+{
+	vector<ContractDefinition const*> contracts;
 	for (auto const& node: m_ast)
 	{
 		SourceUnit const* source = dynamic_cast<SourceUnit const*>(node.get());
 		solAssert(source, "");
 		contracts += source->filteredNodes<ContractDefinition>(source->nodes());
 	}
-
-	// Check modifiers first to infer their state mutability.
-	for (auto const& contract: contracts)
-		for (ModifierDefinition const* mod: contract->functionModifiers())
-			mod->accept(*this);
-
-	for (auto const& contract: contracts)
-		contract->accept(*this);
-
-	return !m_errors;
+	return contracts;
 }
 
 
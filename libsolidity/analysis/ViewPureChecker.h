@@ -35,7 +35,7 @@ namespace dev
 namespace solidity
 {
 
-class ViewPureChecker: private ASTConstVisitor
+class ViewPureChecker: public ASTConstVisitor
 {
 public:
 	ViewPureChecker(std::vector<std::shared_ptr<ASTNode>> const& _ast, langutil::ErrorReporter& _errorReporter):
@@ -43,7 +43,15 @@ public:
 
 	bool check();
 
+	/// Infers the state mutability of all modifiers. This has to be done before the contracts are
+	/// visited, which is what check() does, but they can also be visited by a CompositeASTConstVisitor.
+	void inferModifierMutability();
+	/// @returns true iff no errors were reported.
+	bool succeeded() const { return !m_errors; }
+
 private:
+	std::vector<ContractDefinition const*> contracts() const;
+
 	struct MutabilityAndLocation
 	{
 		StateMutability mutability;
@@ -244,6 +244,44 @@ vector<Declaration const*> const& ContractDefinition::inheritableMembers() const
 	return *m_inheritableMembers;
 }
 
+vector<pair<FunctionDefinition const*, FunctionTypePointer>> const& ContractDefinition::usingForFunctions(Type const& _type) const
+{
+	if (!m_usingForDirectives)
+	{
+		m_usingForDirectives.reset(new vector<pair<TypePointer, ContractDefinition const*>>());
+		for (ContractDefinition const* contract: annotation().linearizedBaseContracts)
+			for (UsingForDirective const* ufd: contract->usingForDirectives())
+				m_usingForDirectives->emplace_back(
+					ufd->typeName() ?
+						ReferenceType::copyForLocationIfReference(DataLocation::Storage, ufd->typeName()->annotation().type) :
+						TypePointer(),
+					&dynamic_cast<ContractDefinition const&>(*ufd->libraryName().annotation().referencedDeclaration)
+				);
+	}
+
+	auto it = m_usingForFunctions.find(_type.identifier());
+	if (it != m_usingForFunctions.end())
+		return it->second;
+
+	set<Declaration const*> seenFunctions;
+	vector<pair<FunctionDefinition const*, FunctionTypePointer>> functions;
+	for (auto const& directive: *m_usingForDirectives)
+	{
+		if (directive.first && _type != *directive.first)
+			continue;
+		for (FunctionDefinition const* function: directive.second->definedFunctions())
+		{
+			if (!function->isVisibleAsLibraryMember() || seenFunctions.count(function))
+				continue;
+			seenFunctions.insert(function);
+			if (function->parameters().empty())
+				continue;
+			functions.emplace_back(function, FunctionType(*function, false).asCallableFunction(true, true));
+		}
+	}
+	return m_usingForFunctions[_type.identifier()] = move(functions);
+}
+
 TypePointer ContractDefinition::type() const
 {
 	return make_shared<TypeType>(make_shared<ContractType>(*this));
@@ -37,6 +37,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace yul
@@ -136,7 +137,7 @@ public:
 	void accept(ASTConstVisitor& _visitor) const override;
 	SourceUnitAnnotation& annotation() const override;
 
-	std::vector<ASTPointer<ASTNode>> nodes() const { return m_nodes; }
+	std::vector<ASTPointer<ASTNode>> const& nodes() const { return m_nodes; }
 
 	/// @returns a set of referenced SourceUnits. Recursively if @a _recurse is true.
 	std::set<SourceUnit const*> referencedSourceUnits(bool _recurse = false, std::set<SourceUnit const*> _skipList = std::set<SourceUnit const*>()) const;
@@ -405,6 +406,13 @@ public:
 	/// @returns a list of the inheritable members of this contract
 	std::vector<Declaration const*> const& inheritableMembers() const;
 
+	/// @returns the library functions that "using for" directives in this contract and its
+	/// bases attach to the given type, in lookup order and together with their callable types.
+	/// @a _type has to be normalised to storage data location. The functions are not yet
+	/// filtered by the type of their first parameter.
+	/// Should only be called after reference resolution.
+	std::vector<std::pair<FunctionDefinition const*, FunctionTypePointer>> const& usingForFunctions(Type const& _type) const;
+
 	/// Returns the constructor or nullptr if no constructor was specified.
 	FunctionDefinition const* constructor() const;
 	/// @returns true iff the constructor of this contract is public (or non-existing).
@@ -432,6 +440,10 @@ private:
 	mutable std::unique_ptr<std::vector<std::pair<FixedHash<4>, FunctionTypePointer>>> m_interfaceFunctionList;
 	mutable std::unique_ptr<std::vector<EventDefinition const*>> m_interfaceEvents;
 	mutable std::unique_ptr<std::vector<Declaration const*>> m_inheritableMembers;
+	/// Normalised types (nullptr for "*") and libraries of all "using for" directives in lookup order.
+	mutable std::unique_ptr<std::vector<std::pair<TypePointer, ContractDefinition const*>>> m_usingForDirectives;
+	/// Cache for usingForFunctions, keyed by type identifier.
+	mutable std::unordered_map<std::string, std::vector<std::pair<FunctionDefinition const*, FunctionTypePointer>>> m_usingForFunctions;
 };
 
 class InheritanceSpecifier: public ASTNode
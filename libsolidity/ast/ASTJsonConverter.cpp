@@ -24,8 +24,12 @@
 #include <libsolidity/ast/AST.h>
 #include <libyul/AsmData.h>
 #include <libyul/AsmPrinter.h>
+#include <libdevcore/JSON.h>
 #include <libdevcore/UTF8.h>
 #include <boost/algorithm/string/join.hpp>
+#include <boost/algorithm/string/replace.hpp>
+
+#include <sstream>
 
 using namespace std;
 using namespace langutil;
@@ -35,6 +39,25 @@ namespace dev
 namespace solidity
 {
 
+namespace
+{
+
+/// @returns @a _value formatted like `operator<<(ostream&, Json::Value const&)` does,
+/// with @a _indent inserted after every line break.
+string indentedJson(Json::Value const& _value, string const& _indent)
+{
+	static Json::StreamWriterBuilder const builder;
+	unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
+	stringstream stream;
+	writer->write(_value, &stream);
+	string output = stream.str();
+	if (!_indent.empty())
+		boost::algorithm::replace_all(output, "\n", "\n" + _indent);
+	return output;
+}
+
+}
+
 ASTJsonConverter::ASTJsonConverter(bool _legacy, map<string, unsigned> _sourceIndices):
 	m_legacy(_legacy),
 	m_sourceIndices(_sourceIndices)
@@ -186,7 +209,94 @@ Json::Value ASTJsonConverter::inlineAssemblyIdentifierToJson(pair<yul::Identifie
 
 void ASTJsonConverter::print(ostream& _stream, ASTNode const& _node)
 {
-	_stream << toJson(_node);
+	if (m_legacy)
+		_stream << toJson(_node);
+	else
+		printStreaming(_stream, _node, "", false);
+}
+
+void ASTJsonConverter::printCompact(ostream& _stream, ASTNode const& _node)
+{
+	if (m_legacy)
+		_stream << jsonCompactPrint(toJson(_node));
+	else
+		printStreaming(_stream, _node, "", true);
+}
+
+void ASTJsonConverter::printStreaming(ostream& _stream, ASTNode const& _node, string const& _indent, bool _compact)
+{
+	auto printValue = [&](Json::Value const& _value, string const& _valueIndent) {
+		_stream << (_compact ? jsonCompactPrint(_value) : indentedJson(_value, _valueIndent));
+	};
+	auto const* children = streamedChildren(_node);
+	if (!children)
+	{
+		printValue(toJson(_node), _indent);
+		return;
+	}
+
+	m_streamingNode = &_node;
+	Json::Value value = toJson(_node);
+	m_streamingNode = nullptr;
+	solAssert(value.isMember("nodes"), "");
+
+	// Mirrors the layout of jsoncpp's styled writer: members sorted by name, compound
+	// members starting on their own line and every array element on its own line.
+	// The compact layout is the same without line breaks and indentation.
+	auto newLine = [&](string const& _lineIndent) {
+		if (!_compact)
+			_stream << "\n" << _lineIndent;
+	};
+	string const memberIndent = _indent + "\t";
+	_stream << "{";
+	bool first = true;
+	for (string const& name: value.getMemberNames())
+	{
+		if (!first)
+			_stream << ",";
+		first = false;
+		newLine(memberIndent);
+		_stream << Json::valueToQuotedString(name.c_str()) << (_compact ? ":" : " : ");
+		if (name == "nodes")
+		{
+			if (children->empty())
+			{
+				_stream << "[]";
+				continue;
+			}
+			string const elementIndent = memberIndent + "\t";
+			newLine(memberIndent);
+			_stream << "[";
+			for (size_t i = 0; i < children->size(); ++i)
+			{
+				solAssert((*children)[i], "");
+				if (i != 0)
+					_stream << ",";
+				newLine(elementIndent);
+				printStreaming(_stream, *(*children)[i], elementIndent, _compact);
+			}
+			newLine(memberIndent);
+			_stream << "]";
+		}
+		else
+		{
+			Json::Value const& member = value[name];
+			if ((member.isObject() || member.isArray()) && !member.empty())
+				newLine(memberIndent);
+			printValue(member, memberIndent);
+		}
+	}
+	newLine(_indent);
+	_stream << "}";
+}
+
+vector<ASTPointer<ASTNode>> const* ASTJsonConverter::streamedChildren(ASTNode const& _node) const
+{
+	if (auto sourceUnit = dynamic_cast<SourceUnit const*>(&_node))
+		return &sourceUnit->nodes();
+	else if (auto contract = dynamic_cast<ContractDefinition const*>(&_node))
+		return &contract->subNodes();
+	return nullptr;
 }
 
 Json::Value&& ASTJsonConverter::toJson(ASTNode const& _node)
@@ -210,7 +320,7 @@ bool ASTJsonConverter::visit(SourceUnit const& _node)
 		{
 			make_pair("absolutePath", _node.annotation().path),
 			make_pair("exportedSymbols", move(exportedSymbols)),
-			make_pair("nodes", toJson(_node.nodes()))
+			make_pair("nodes", childrenToJson(_node, _node.nodes()))
 		}
 	);
 	return false;
@@ -260,7 +370,7 @@ bool ASTJsonConverter::visit(ContractDefinition const& _node)
 		make_pair("linearizedBaseContracts", getContainerIds(_node.annotation().linearizedBaseContracts)),
 		make_pair("baseContracts", toJson(_node.baseContracts())),
 		make_pair("contractDependencies", getContainerIds(_node.annotation().contractDependencies)),
-		make_pair("nodes", toJson(_node.subNodes())),
+		make_pair("nodes", childrenToJson(_node, _node.subNodes())),
 		make_pair("scope", idOrNull(_node.scope()))
 	});
 	return false;
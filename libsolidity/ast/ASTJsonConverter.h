@@ -54,7 +54,12 @@ public:
 		std::map<std::string, unsigned> _sourceIndices = std::map<std::string, unsigned>()
 	);
 	/// Output the json representation of the AST to _stream.
+	/// In the non-legacy format, the children of source units and contracts are
+	/// converted and written one at a time, so the full tree is never held in memory.
 	void print(std::ostream& _stream, ASTNode const& _node);
+	/// Output the json representation of the AST to _stream in the format of jsonCompactPrint.
+	/// Like print, it writes the children of source units and contracts one at a time.
+	void printCompact(std::ostream& _stream, ASTNode const& _node);
 	Json::Value&& toJson(ASTNode const& _node);
 	template <class T>
 	Json::Value toJson(std::vector<ASTPointer<T>> const& _nodes)
@@ -126,6 +131,17 @@ private:
 		std::string const& _nodeName,
 		std::vector<std::pair<std::string, Json::Value>>&& _attributes
 	);
+	/// Writes @a _node to @a _stream in the same format as `_stream << toJson(_node)`,
+	/// where every line after the first is prefixed by @a _indent, or in the format of
+	/// `jsonCompactPrint(toJson(_node))` if @a _compact is true.
+	void printStreaming(std::ostream& _stream, ASTNode const& _node, std::string const& _indent, bool _compact);
+	/// @returns the nodes that are written one by one when streaming @a _node, or nullptr.
+	std::vector<ASTPointer<ASTNode>> const* streamedChildren(ASTNode const& _node) const;
+	/// @returns the child nodes of @a _node unless they are streamed separately.
+	Json::Value childrenToJson(ASTNode const& _node, std::vector<ASTPointer<ASTNode>> const& _children)
+	{
+		return &_node == m_streamingNode ? Json::Value(Json::arrayValue) : toJson(_children);
+	}
 	std::string sourceLocationToString(langutil::SourceLocation const& _location) const;
 	static std::string namePathToString(std::vector<ASTString> const& _namePath);
 	static Json::Value idOrNull(ASTNode const* _pt)
@@ -173,6 +189,8 @@ private:
 	bool m_legacy = false; ///< if true, use legacy format
 	bool m_inEvent = false; ///< whether we are currently inside an event or not
 	Json::Value m_currentValue;
+	/// Node whose children are currently being written by printStreaming.
+	ASTNode const* m_streamingNode = nullptr;
 	std::map<std::string, unsigned> m_sourceIndices;
 };
 
@@ -312,5 +312,144 @@ private:
 	std::function<void(ASTNode const&, ASTNode const&)> m_onEdge;
 };
 
+
+/**
+ * Runs several independent visitors in a single traversal of the AST.
+ * The visitors are called for each node in the order they were given. If a visitor returns
+ * false for a node, it is not called for the children of that node, but the others are.
+ * endVisit is called for every visitor that visit was called for.
+ * The visitors may traverse parts of the AST on their own, but must not modify it.
+ */
+class CompositeASTConstVisitor: public ASTConstVisitor
+{
+public:
+	explicit CompositeASTConstVisitor(std::vector<ASTConstVisitor*> _visitors):
+		m_visitors(std::move(_visitors)),
+		m_skippedFrom(m_visitors.size(), nullptr)
+	{}
+
+	bool visit(SourceUnit const& _node) override { return visitAll(_node); }
+	bool visit(PragmaDirective const& _node) override { return visitAll(_node); }
+	bool visit(ImportDirective const& _node) override { return visitAll(_node); }
+	bool visit(ContractDefinition const& _node) override { return visitAll(_node); }
+	bool visit(InheritanceSpecifier const& _node) override { return visitAll(_node); }
+	bool visit(StructDefinition const& _node) override { return visitAll(_node); }
+	bool visit(UsingForDirective const& _node) override { return visitAll(_node); }
+	bool visit(EnumDefinition const& _node) override { return visitAll(_node); }
+	bool visit(EnumValue const& _node) override { return visitAll(_node); }
+	bool visit(ParameterList const& _node) override { return visitAll(_node); }
+	bool visit(FunctionDefinition const& _node) override { return visitAll(_node); }
+	bool visit(VariableDeclaration const& _node) override { return visitAll(_node); }
+	bool visit(ModifierDefinition const& _node) override { return visitAll(_node); }
+	bool visit(ModifierInvocation const& _node) override { return visitAll(_node); }
+	bool visit(EventDefinition const& _node) override { return visitAll(_node); }
+	bool visit(ElementaryTypeName const& _node) override { return visitAll(_node); }
+	bool visit(UserDefinedTypeName const& _node) override { return visitAll(_node); }
+	bool visit(FunctionTypeName const& _node) override { return visitAll(_node); }
+	bool visit(Mapping const& _node) override { return visitAll(_node); }
+	bool visit(ArrayTypeName const& _node) override { return visitAll(_node); }
+	bool visit(Block const& _node) override { return visitAll(_node); }
+	bool visit(PlaceholderStatement const& _node) override { return visitAll(_node); }
+	bool visit(IfStatement const& _node) override { return visitAll(_node); }
+	bool visit(WhileStatement const& _node) override { return visitAll(_node); }
+	bool visit(ForStatement const& _node) override { return visitAll(_node); }
+	bool visit(Continue const& _node) override { return visitAll(_node); }
+	bool visit(InlineAssembly const& _node) override { return visitAll(_node); }
+	bool visit(Break const& _node) override { return visitAll(_node); }
+	bool visit(Return const& _node) override { return visitAll(_node); }
+	bool visit(Throw const& _node) override { return visitAll(_node); }
+	bool visit(EmitStatement const& _node) override { return visitAll(_node); }
+	bool visit(VariableDeclarationStatement const& _node) override { return visitAll(_node); }
+	bool visit(ExpressionStatement const& _node) override { return visitAll(_node); }
+	bool visit(Conditional const& _node) override { return visitAll(_node); }
+	bool visit(Assignment const& _node) override { return visitAll(_node); }
+	bool visit(TupleExpression const& _node) override { return visitAll(_node); }
+	bool visit(UnaryOperation const& _node) override { return visitAll(_node); }
+	bool visit(BinaryOperation const& _node) override { return visitAll(_node); }
+	bool visit(FunctionCall const& _node) override { return visitAll(_node); }
+	bool visit(NewExpression const& _node) override { return visitAll(_node); }
+	bool visit(MemberAccess const& _node) override { return visitAll(_node); }
+	bool visit(IndexAccess const& _node) override { return visitAll(_node); }
+	bool visit(Identifier const& _node) override { return visitAll(_node); }
+	bool visit(ElementaryTypeNameExpression const& _node) override { return visitAll(_node); }
+	bool visit(Literal const& _node) override { return visitAll(_node); }
+
+	void endVisit(SourceUnit const& _node) override { endVisitAll(_node); }
+	void endVisit(PragmaDirective const& _node) override { endVisitAll(_node); }
+	void endVisit(ImportDirective const& _node) override { endVisitAll(_node); }
+	void endVisit(ContractDefinition const& _node) override { endVisitAll(_node); }
+	void endVisit(InheritanceSpecifier const& _node) override { endVisitAll(_node); }
+	void endVisit(StructDefinition const& _node) override { endVisitAll(_node); }
+	void endVisit(UsingForDirective const& _node) override { endVisitAll(_node); }
+	void endVisit(EnumDefinition const& _node) override { endVisitAll(_node); }
+	void endVisit(EnumValue const& _node) override { endVisitAll(_node); }
+	void endVisit(ParameterList const& _node) override { endVisitAll(_node); }
+	void endVisit(FunctionDefinition const& _node) override { endVisitAll(_node); }
+	void endVisit(VariableDeclaration const& _node) override { endVisitAll(_node); }
+	void endVisit(ModifierDefinition const& _node) override { endVisitAll(_node); }
+	void endVisit(ModifierInvocation const& _node) override { endVisitAll(_node); }
+	void endVisit(EventDefinition const& _node) override { endVisitAll(_node); }
+	void endVisit(ElementaryTypeName const& _node) override { endVisitAll(_node); }
+	void endVisit(UserDefinedTypeName const& _node) override { endVisitAll(_node); }
+	void endVisit(FunctionTypeName const& _node) override { endVisitAll(_node); }
+	void endVisit(Mapping const& _node) override { endVisitAll(_node); }
+	void endVisit(ArrayTypeName const& _node) override { endVisitAll(_node); }
+	void endVisit(Block const& _node) override { endVisitAll(_node); }
+	void endVisit(PlaceholderStatement const& _node) override { endVisitAll(_node); }
+	void endVisit(IfStatement const& _node) override { endVisitAll(_node); }
+	void endVisit(WhileStatement const& _node) override { endVisitAll(_node); }
+	void endVisit(ForStatement const& _node) override { endVisitAll(_node); }
+	void endVisit(Continue const& _node) override { endVisitAll(_node); }
+	void endVisit(InlineAssembly const& _node) override { endVisitAll(_node); }
+	void endVisit(Break const& _node) override { endVisitAll(_node); }
+	void endVisit(Return const& _node) override { endVisitAll(_node); }
+	void endVisit(Throw const& _node) override { endVisitAll(_node); }
+	void endVisit(EmitStatement const& _node) override { endVisitAll(_node); }
+	void endVisit(VariableDeclarationStatement const& _node) override { endVisitAll(_node); }
+	void endVisit(ExpressionStatement const& _node) override { endVisitAll(_node); }
+	void endVisit(Conditional const& _node) override { endVisitAll(_node); }
+	void endVisit(Assignment const& _node) override { endVisitAll(_node); }
+	void endVisit(TupleExpression const& _node) override { endVisitAll(_node); }
+	void endVisit(UnaryOperation const& _node) override { endVisitAll(_node); }
+	void endVisit(BinaryOperation const& _node) override { endVisitAll(_node); }
+	void endVisit(FunctionCall const& _node) override { endVisitAll(_node); }
+	void endVisit(NewExpression const& _node) override { endVisitAll(_node); }
+	void endVisit(MemberAccess const& _node) override { endVisitAll(_node); }
+	void endVisit(IndexAccess const& _node) override { endVisitAll(_node); }
+	void endVisit(Identifier const& _node) override { endVisitAll(_node); }
+	void endVisit(ElementaryTypeNameExpression const& _node) override { endVisitAll(_node); }
+	void endVisit(Literal const& _node) override { endVisitAll(_node); }
+
+private:
+	template <class T>
+	bool visitAll(T const& _node)
+	{
+		bool visitChildren = false;
+		for (size_t i = 0; i < m_visitors.size(); ++i)
+			if (!m_skippedFrom[i])
+			{
+				if (m_visitors[i]->visit(_node))
+					visitChildren = true;
+				else
+					m_skippedFrom[i] = &_node;
+			}
+		return visitChildren;
+	}
+	template <class T>
+	void endVisitAll(T const& _node)
+	{
+		for (size_t i = 0; i < m_visitors.size(); ++i)
+			if (!m_skippedFrom[i] || m_skippedFrom[i] == &_node)
+			{
+				m_skippedFrom[i] = nullptr;
+				m_visitors[i]->endVisit(_node);
+			}
+	}
+
+	std::vector<ASTConstVisitor*> m_visitors;
+	/// For each visitor, the node whose children it is not called for, if any.
+	std::vector<ASTNode const*> m_skippedFrom;
+};
+
 }
 }
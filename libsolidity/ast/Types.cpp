@@ -446,31 +446,10 @@ MemberList::MemberMap Type::boundFunctions(Type const& _type, ContractDefinition
 {
 	// Normalise data location of type.
 	TypePointer type = ReferenceType::copyForLocationIfReference(DataLocation::Storage, _type.shared_from_this());
-	set<Declaration const*> seenFunctions;
 	MemberList::MemberMap members;
-	for (ContractDefinition const* contract: _scope.annotation().linearizedBaseContracts)
-		for (UsingForDirective const* ufd: contract->usingForDirectives())
-		{
-			if (ufd->typeName() && *type != *ReferenceType::copyForLocationIfReference(
-				DataLocation::Storage,
-				ufd->typeName()->annotation().type
-			))
-				continue;
-			auto const& library = dynamic_cast<ContractDefinition const&>(
-				*ufd->libraryName().annotation().referencedDeclaration
-			);
-			for (FunctionDefinition const* function: library.definedFunctions())
-			{
-				if (!function->isVisibleAsLibraryMember() || seenFunctions.count(function))
-					continue;
-				seenFunctions.insert(function);
-				if (function->parameters().empty())
-					continue;
-				FunctionTypePointer fun = FunctionType(*function, false).asCallableFunction(true, true);
-				if (_type.isImplicitlyConvertibleTo(*fun->selfType()))
-					members.emplace_back(function->name(), fun, function);
-			}
-		}
+	for (auto const& function: _scope.usingForFunctions(*type))
+		if (_type.isImplicitlyConvertibleTo(*function.second->selfType()))
+			members.emplace_back(function.first->name(), function.second, function.first);
 	return members;
 }
 
@@ -51,6 +51,13 @@ void Compiler::compileContract(
 	m_context.optimise(m_optimiserSettings);
 }
 
+void Compiler::updateMetadata(map<bytes, bytes> const& _replacements)
+{
+	solAssert(m_runtimeSub != size_t(-1), "Contract has not been compiled.");
+	m_context.assemblyPtr()->replaceAuxiliaryData(_replacements);
+	m_context.assemblyPtr()->discardAssembledObject();
+}
+
 std::shared_ptr<eth::Assembly> Compiler::runtimeAssemblyPtr() const
 {
 	solAssert(m_context.runtimeContext(), "");
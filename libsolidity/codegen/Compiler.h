@@ -48,6 +48,10 @@ public:
 		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> const& _otherCompilers,
 		bytes const& _metadata
 	);
+	/// Replaces the metadata CBOR of the compiled contract and of the contracts it creates,
+	/// given as a map from old to new metadata, so that its code can be reused after sources
+	/// that only influence the metadata changed.
+	void updateMetadata(std::map<bytes, bytes> const& _replacements);
 	/// @returns Entire assembly.
 	eth::Assembly const& assembly() const { return m_context.assembly(); }
 	/// @returns Entire assembly as a shared pointer to non-const.
@@ -59,12 +63,12 @@ public:
 	/// @returns Only the runtime object (without constructor).
 	eth::LinkerObject runtimeObject() const { return m_context.assembledRuntimeObject(m_runtimeSub); }
 	/// @arg _sourceCodes is the map of input files to source code strings
-	std::string assemblyString(StringMap const& _sourceCodes = StringMap()) const
+	std::string assemblyString(SharedStringMap const& _sourceCodes = SharedStringMap()) const
 	{
 		return m_context.assemblyString(_sourceCodes);
 	}
 	/// @arg _sourceCodes is the map of input files to source code strings
-	Json::Value assemblyJSON(StringMap const& _sourceCodes = StringMap()) const
+	Json::Value assemblyJSON(SharedStringMap const& _sourceCodes = SharedStringMap()) const
 	{
 		return m_context.assemblyJSON(_sourceCodes);
 	}
@@ -25,6 +25,7 @@
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/codegen/Compiler.h>
 #include <libsolidity/codegen/CompilerUtils.h>
+#include <libsolidity/codegen/OptimisedAssemblyCache.h>
 #include <libsolidity/interface/Version.h>
 
 #include <libyul/AsmParser.h>
@@ -381,12 +382,6 @@ void CompilerContext::appendInlineAssembly(
 
 	ErrorList errors;
 	ErrorReporter errorReporter(errors);
-	auto scanner = make_shared<langutil::Scanner>(langutil::CharStream(_assembly, "--CODEGEN--"));
-	auto parserResult = yul::Parser(errorReporter, yul::EVMDialect::strictAssemblyForEVM(m_evmVersion)).parse(scanner, false);
-#ifdef SOL_OUTPUT_ASM
-	cout << yul::AsmPrinter()(*parserResult) << endl;
-#endif
-
 	auto reportError = [&](string const& _context)
 	{
 		string message =
@@ -405,43 +400,82 @@ void CompilerContext::appendInlineAssembly(
 		solAssert(false, message);
 	};
 
-	yul::AsmAnalysisInfo analysisInfo;
-	bool analyzerResult = false;
-	if (parserResult)
-		analyzerResult = yul::AsmAnalyzer(
-			analysisInfo,
-			errorReporter,
-			boost::none,
-			yul::EVMDialect::strictAssemblyForEVM(m_evmVersion),
-			identifierAccess.resolve
-		).analyze(*parserResult);
-	if (!parserResult || !errorReporter.errors().empty() || !analyzerResult)
-		reportError("Invalid assembly generated by code generator.");
-
 	// Several optimizer steps cannot handle externally supplied stack variables,
 	// so we essentially only optimize the ABI functions.
-	if (_optimiserSettings.runYulOptimiser && _localVariables.empty())
+	bool const optimize = _optimiserSettings.runYulOptimiser && _localVariables.empty();
+	h256 cacheKey;
+	shared_ptr<yul::Block const> code;
+	if (optimize)
 	{
-		yul::OptimiserSuite::run(
-			yul::EVMDialect::strictAssemblyForEVM(m_evmVersion),
-			*parserResult,
-			analysisInfo,
-			_optimiserSettings.optimizeStackAllocation,
+		cacheKey = OptimisedAssemblyCache::key(
+			_assembly,
+			m_evmVersion,
+			_optimiserSettings,
 			externallyUsedIdentifiers
 		);
-		analysisInfo = yul::AsmAnalysisInfo{};
+		code = OptimisedAssemblyCache::instance().find(cacheKey);
+	}
+
+	yul::AsmAnalysisInfo analysisInfo;
+	if (code)
+	{
+		// The block was analyzed successfully when it was stored, so this cannot fail.
 		if (!yul::AsmAnalyzer(
 			analysisInfo,
 			errorReporter,
 			boost::none,
 			yul::EVMDialect::strictAssemblyForEVM(m_evmVersion),
 			identifierAccess.resolve
-		).analyze(*parserResult))
-			reportError("Optimizer introduced error into inline assembly.");
+		).analyze(*code))
+			reportError("Cached optimized inline assembly failed to analyze.");
+	}
+	else
+	{
+		auto scanner = make_shared<langutil::Scanner>(langutil::CharStream(_assembly, "--CODEGEN--"));
+		auto parserResult = yul::Parser(errorReporter, yul::EVMDialect::strictAssemblyForEVM(m_evmVersion)).parse(scanner, false);
 #ifdef SOL_OUTPUT_ASM
-		cout << "After optimizer: " << endl;
 		cout << yul::AsmPrinter()(*parserResult) << endl;
 #endif
+
+		bool analyzerResult = false;
+		if (parserResult)
+			analyzerResult = yul::AsmAnalyzer(
+				analysisInfo,
+				errorReporter,
+				boost::none,
+				yul::EVMDialect::strictAssemblyForEVM(m_evmVersion),
+				identifierAccess.resolve
+			).analyze(*parserResult);
+		if (!parserResult || !errorReporter.errors().empty() || !analyzerResult)
+			reportError("Invalid assembly generated by code generator.");
+
+		if (optimize)
+		{
+			yul::OptimiserSuite::run(
+				yul::EVMDialect::strictAssemblyForEVM(m_evmVersion),
+				*parserResult,
+				analysisInfo,
+				_optimiserSettings.optimizeStackAllocation,
+				externallyUsedIdentifiers,
+				_optimiserSettings.expectedExecutionsPerDeployment
+			);
+			analysisInfo = yul::AsmAnalysisInfo{};
+			if (!yul::AsmAnalyzer(
+				analysisInfo,
+				errorReporter,
+				boost::none,
+				yul::EVMDialect::strictAssemblyForEVM(m_evmVersion),
+				identifierAccess.resolve
+			).analyze(*parserResult))
+				reportError("Optimizer introduced error into inline assembly.");
+#ifdef SOL_OUTPUT_ASM
+			cout << "After optimizer: " << endl;
+			cout << yul::AsmPrinter()(*parserResult) << endl;
+#endif
+			if (errorReporter.errors().empty())
+				OptimisedAssemblyCache::instance().insert(cacheKey, parserResult);
+		}
+		code = move(parserResult);
 	}
 
 	if (!errorReporter.errors().empty())
@@ -449,7 +483,7 @@ void CompilerContext::appendInlineAssembly(
 
 	solAssert(errorReporter.errors().empty(), "Failed to analyze inline assembly block.");
 	yul::CodeGenerator::assemble(
-		*parserResult,
+		*code,
 		analysisInfo,
 		*m_asm,
 		m_evmVersion,
@@ -238,13 +238,13 @@ public:
 	std::shared_ptr<eth::Assembly> assemblyPtr() const { return m_asm; }
 
 	/// @arg _sourceCodes is the map of input files to source code strings
-	std::string assemblyString(StringMap const& _sourceCodes = StringMap()) const
+	std::string assemblyString(SharedStringMap const& _sourceCodes = SharedStringMap()) const
 	{
 		return m_asm->assemblyString(_sourceCodes);
 	}
 
 	/// @arg _sourceCodes is the map of input files to source code strings
-	Json::Value assemblyJSON(StringMap const& _sourceCodes = StringMap()) const
+	Json::Value assemblyJSON(SharedStringMap const& _sourceCodes = SharedStringMap()) const
 	{
 		return m_asm->assemblyJSON(_sourceCodes);
 	}
@@ -255,28 +255,7 @@ void StorageItem::storeValue(Type const& _sourceType, SourceLocation const& _loc
 			// stack: value storage_ref cleared_value multiplier
 			utils.copyToStackTop(3 + m_dataType->sizeOnStack(), m_dataType->sizeOnStack());
 			// stack: value storage_ref cleared_value multiplier value
-			if (FunctionType const* fun = dynamic_cast<decltype(fun)>(m_dataType))
-			{
-				solAssert(_sourceType == *m_dataType, "function item stored but target is not equal to source");
-				if (fun->kind() == FunctionType::Kind::External)
-					// Combine the two-item function type into a single stack slot.
-					utils.combineExternalFunctionType(false);
-				else
-					m_context <<
-						((u256(1) << (8 * m_dataType->storageBytes())) - 1) <<
-						Instruction::AND;
-			}
-			else if (m_dataType->category() == Type::Category::FixedBytes)
-			{
-				solAssert(_sourceType.category() == Type::Category::FixedBytes, "source not fixed bytes");
-				CompilerUtils(m_context).rightShiftNumberOnStack(256 - 8 * dynamic_cast<FixedBytesType const&>(*m_dataType).numBytes());
-			}
-			else
-			{
-				solAssert(m_dataType->sizeOnStack() == 1, "Invalid stack size for opaque type.");
-				// remove the higher order bits
-				utils.convertType(_sourceType, *m_dataType, true, true);
-			}
+			convertToPackedStorage(_sourceType);
 			m_context  << Instruction::MUL << Instruction::OR;
 			// stack: value storage_ref updated_value
 			m_context << Instruction::SWAP1 << Instruction::SSTORE;
@@ -311,39 +290,85 @@ void StorageItem::storeValue(Type const& _sourceType, SourceLocation const& _loc
 				"Struct assignment with conversion."
 			);
 			solAssert(sourceType.location() != DataLocation::CallData, "Structs in calldata not supported.");
-			for (auto const& member: structType.members(nullptr))
+			// stack layout: source_ref target_ref
+			auto loadSourceMember = [&](string const& _name, unsigned _sourceRefDepth)
 			{
-				// assign each member that is not a mapping
-				TypePointer const& memberType = member.type;
-				if (memberType->category() == Type::Category::Mapping)
-					continue;
-				TypePointer sourceMemberType = sourceType.memberType(member.name);
+				TypePointer sourceMemberType = sourceType.memberType(_name);
 				if (sourceType.location() == DataLocation::Storage)
 				{
-					// stack layout: source_ref target_ref
-					pair<u256, unsigned> const& offsets = sourceType.storageOffsetsOfMember(member.name);
-					m_context << offsets.first << Instruction::DUP3 << Instruction::ADD;
+					pair<u256, unsigned> const& offsets = sourceType.storageOffsetsOfMember(_name);
+					m_context << offsets.first << dupInstruction(_sourceRefDepth + 1) << Instruction::ADD;
 					m_context << u256(offsets.second);
-					// stack: source_ref target_ref source_member_ref source_member_off
+					// stack: ... source_member_ref source_member_off
 					StorageItem(m_context, *sourceMemberType).retrieveValue(_location, true);
-					// stack: source_ref target_ref source_value...
 				}
 				else
 				{
 					solAssert(sourceType.location() == DataLocation::Memory, "");
-					// stack layout: source_ref target_ref
-					TypePointer sourceMemberType = sourceType.memberType(member.name);
-					m_context << sourceType.memoryOffsetOfMember(member.name);
-					m_context << Instruction::DUP3 << Instruction::ADD;
+					m_context << sourceType.memoryOffsetOfMember(_name);
+					m_context << dupInstruction(_sourceRefDepth + 1) << Instruction::ADD;
 					MemoryItem(m_context, *sourceMemberType).retrieveValue(_location, true);
-					// stack layout: source_ref target_ref source_value...
 				}
+				// stack: ... source_value...
+			};
+			auto isPacked = [](MemberList::Member const& _member)
+			{
+				return _member.type->isValueType() && _member.type->storageBytes() < 32;
+			};
+			MemberList::MemberMap const members(structType.members(nullptr).begin(), structType.members(nullptr).end());
+			for (size_t i = 0; i < members.size();)
+			{
+				// assign each member that is not a mapping
+				TypePointer const& memberType = members[i].type;
+				if (memberType->category() == Type::Category::Mapping)
+				{
+					++i;
+					continue;
+				}
+				u256 const slot = structType.storageOffsetsOfMember(members[i].name).first;
+				size_t groupEnd = i + 1;
+				if (isPacked(members[i]))
+					while (
+						groupEnd < members.size() &&
+						isPacked(members[groupEnd]) &&
+						structType.storageOffsetsOfMember(members[groupEnd].name).first == slot
+					)
+						++groupEnd;
+				if (groupEnd - i > 1)
+				{
+					// Several members share this slot: update all of them with a
+					// single SLOAD and SSTORE instead of one read-modify-write each.
+					m_context << Instruction::DUP1 << slot << Instruction::ADD;
+					m_context << Instruction::DUP1 << Instruction::SLOAD;
+					// stack: source_ref target_ref target_slot_ref slot_value
+					for (; i < groupEnd; ++i)
+					{
+						TypePointer const& packedType = members[i].type;
+						u256 const multiplier = u256(1) << (8 * structType.storageOffsetsOfMember(members[i].name).second);
+						// clear bytes in old value
+						m_context << ~(((u256(1) << (8 * packedType->storageBytes())) - 1) * multiplier);
+						m_context << Instruction::AND;
+						loadSourceMember(members[i].name, 4);
+						// stack: source_ref target_ref target_slot_ref cleared_value source_value...
+						StorageItem(m_context, *packedType).convertToPackedStorage(*sourceType.memberType(members[i].name));
+						if (multiplier != 1)
+							m_context << multiplier << Instruction::MUL;
+						m_context << Instruction::OR;
+						// stack: source_ref target_ref target_slot_ref updated_value
+					}
+					m_context << Instruction::SWAP1 << Instruction::SSTORE;
+					continue;
+				}
+				TypePointer sourceMemberType = sourceType.memberType(members[i].name);
+				loadSourceMember(members[i].name, 2);
+				// stack: source_ref target_ref source_value...
 				unsigned stackSize = sourceMemberType->sizeOnStack();
-				pair<u256, unsigned> const& offsets = structType.storageOffsetsOfMember(member.name);
+				pair<u256, unsigned> const& offsets = structType.storageOffsetsOfMember(members[i].name);
 				m_context << dupInstruction(1 + stackSize) << offsets.first << Instruction::ADD;
 				m_context << u256(offsets.second);
 				// stack: source_ref target_ref target_off source_value... target_member_ref target_member_byte_off
 				StorageItem(m_context, *memberType).storeValue(*sourceMemberType, _location, true);
+				++i;
 			}
 			// stack layout: source_ref target_ref
 			solAssert(sourceType.sizeOnStack() == 1, "Unexpected source size.");
@@ -360,6 +385,35 @@ void StorageItem::storeValue(Type const& _sourceType, SourceLocation const& _loc
 	}
 }
 
+void StorageItem::convertToPackedStorage(Type const& _sourceType) const
+{
+	CompilerUtils utils(m_context);
+	// stack: value
+	if (FunctionType const* fun = dynamic_cast<decltype(fun)>(m_dataType))
+	{
+		solAssert(_sourceType == *m_dataType, "function item stored but target is not equal to source");
+		if (fun->kind() == FunctionType::Kind::External)
+			// Combine the two-item function type into a single stack slot.
+			utils.combineExternalFunctionType(false);
+		else
+			m_context <<
+				((u256(1) << (8 * m_dataType->storageBytes())) - 1) <<
+				Instruction::AND;
+	}
+	else if (m_dataType->category() == Type::Category::FixedBytes)
+	{
+		solAssert(_sourceType.category() == Type::Category::FixedBytes, "source not fixed bytes");
+		utils.rightShiftNumberOnStack(256 - 8 * dynamic_cast<FixedBytesType const&>(*m_dataType).numBytes());
+	}
+	else
+	{
+		solAssert(m_dataType->sizeOnStack() == 1, "Invalid stack size for opaque type.");
+		// remove the higher order bits
+		utils.convertType(_sourceType, *m_dataType, true, true);
+	}
+	// stack: packed_value
+}
+
 void StorageItem::setToZero(SourceLocation const&, bool _removeReference) const
 {
 	if (m_dataType->category() == Type::Category::Array)
@@ -147,6 +147,11 @@ public:
 		langutil::SourceLocation const& _location = {},
 		bool _removeReference = true
 	) const override;
+
+private:
+	/// Converts the value of type @a _sourceType on top of the stack into a single stack slot
+	/// holding the storage representation of this packed type in its lower-order bytes.
+	void convertToPackedStorage(Type const& _sourceType) const;
 };
 
 /**
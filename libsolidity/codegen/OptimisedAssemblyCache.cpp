@@ -0,0 +1,86 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Process-wide memo of compiler-generated assembly blocks after the Yul optimiser ran on them.
+ */
+
+#include <libsolidity/codegen/OptimisedAssemblyCache.h>
+
+#include <libdevcore/Keccak256.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+OptimisedAssemblyCache& OptimisedAssemblyCache::instance()
+{
+	static OptimisedAssemblyCache cache;
+	return cache;
+}
+
+h256 OptimisedAssemblyCache::key(
+	string const& _assembly,
+	langutil::EVMVersion _evmVersion,
+	OptimiserSettings const& _optimiserSettings,
+	set<yul::YulString> const& _externallyUsedIdentifiers
+)
+{
+	string key = _assembly + '\0' + _evmVersion.name() + '\0';
+	for (bool setting: {
+		_optimiserSettings.runOrderLiterals,
+		_optimiserSettings.runJumpdestRemover,
+		_optimiserSettings.runPeephole,
+		_optimiserSettings.runDeduplicate,
+		_optimiserSettings.runCSE,
+		_optimiserSettings.runConstantOptimiser,
+		_optimiserSettings.optimizeStackAllocation,
+		_optimiserSettings.runYulOptimiser
+	})
+		key += setting ? '1' : '0';
+	key += '\0' + to_string(_optimiserSettings.expectedExecutionsPerDeployment);
+	for (auto const& identifier: _externallyUsedIdentifiers)
+		key += '\0' + identifier.str();
+	return keccak256(key);
+}
+
+shared_ptr<yul::Block const> OptimisedAssemblyCache::find(h256 const& _key) const
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_blocks.find(_key);
+	return it == m_blocks.end() ? nullptr : it->second;
+}
+
+void OptimisedAssemblyCache::insert(h256 const& _key, shared_ptr<yul::Block const> _block)
+{
+	lock_guard<mutex> lock(m_mutex);
+	// Keep long-running processes bounded, the helpers of a project are far fewer than this.
+	if (m_blocks.size() >= c_maxEntries)
+		m_blocks.clear();
+	m_blocks[_key] = move(_block);
+}
+
+size_t OptimisedAssemblyCache::size() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_blocks.size();
+}
+
+void OptimisedAssemblyCache::clear()
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_blocks.clear();
+}
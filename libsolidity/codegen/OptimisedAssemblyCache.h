@@ -0,0 +1,83 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Process-wide memo of compiler-generated assembly blocks after the Yul optimiser ran on them.
+ */
+
+#pragma once
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <libyul/AsmDataForward.h>
+#include <libyul/YulString.h>
+
+#include <liblangutil/EVMVersion.h>
+
+#include <libdevcore/FixedHash.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace dev
+{
+namespace solidity
+{
+
+/**
+ * Memo of compiler-generated assembly blocks after the Yul optimiser ran on them, shared by
+ * all compilations in a process. The optimiser is deterministic, so identical input text and
+ * settings yield the same block.
+ */
+class OptimisedAssemblyCache: boost::noncopyable
+{
+public:
+	static OptimisedAssemblyCache& instance();
+
+	/// @returns the key of @a _assembly optimised with the given settings. Everything the
+	/// optimiser depends on is part of it, so blocks optimised differently never share an entry.
+	static h256 key(
+		std::string const& _assembly,
+		langutil::EVMVersion _evmVersion,
+		OptimiserSettings const& _optimiserSettings,
+		std::set<yul::YulString> const& _externallyUsedIdentifiers
+	);
+
+	/// @returns the block stored for @a _key or nullptr.
+	std::shared_ptr<yul::Block const> find(h256 const& _key) const;
+	void insert(h256 const& _key, std::shared_ptr<yul::Block const> _block);
+
+	size_t size() const;
+	void clear();
+
+private:
+	OptimisedAssemblyCache() = default;
+
+	static size_t const c_maxEntries = 4096;
+
+	mutable std::mutex m_mutex;
+	std::map<h256, std::shared_ptr<yul::Block const>> m_blocks;
+	/// The cached blocks refer to interned strings and have to go together with them.
+	yul::YulStringRepository::ResetCallback m_resetCallback{[this]() { clear(); }};
+};
+
+}
+}
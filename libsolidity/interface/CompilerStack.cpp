@@ -38,9 +38,11 @@
 #include <libsolidity/analysis/ViewPureChecker.h>
 
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
 #include <libsolidity/codegen/Compiler.h>
 #include <libsolidity/formal/SMTChecker.h>
 #include <libsolidity/interface/ABI.h>
+#include <libsolidity/interface/ContractFingerprints.h>
 #include <libsolidity/interface/Natspec.h>
 #include <libsolidity/interface/GasEstimator.h>
 #include <libsolidity/interface/Version.h>
@@ -52,6 +54,7 @@
 
 #include <libevmasm/Exceptions.h>
 
+#include <libdevcore/Keccak256.h>
 #include <libdevcore/SwarmHash.h>
 #include <libdevcore/JSON.h>
 
@@ -97,6 +100,8 @@ void CompilerStack::setEVMVersion(langutil::EVMVersion _version)
 {
 	if (m_stackState >= ParsingSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set EVM version before parsing."));
+	if (!(_version == m_evmVersion))
+		m_previousCode.clear();
 	m_evmVersion = _version;
 }
 
@@ -118,6 +123,8 @@ void CompilerStack::setOptimiserSettings(OptimiserSettings _settings)
 {
 	if (m_stackState >= ParsingSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set optimiser settings before parsing."));
+	if (!(_settings == m_optimiserSettings))
+		m_previousCode.clear();
 	m_optimiserSettings = std::move(_settings);
 }
 
@@ -148,22 +155,36 @@ void CompilerStack::reset(bool _keepSettings)
 		m_evmVersion = langutil::EVMVersion();
 		m_optimiserSettings = OptimiserSettings::minimal();
 		m_metadataLiteralSources = false;
+		m_previousCode.clear();
 	}
 	m_globalContext.reset();
 	m_scopes.clear();
 	m_sourceOrder.clear();
 	m_contracts.clear();
+	m_generatedContractNames.clear();
+	m_sourceIndices.reset();
 	m_errorReporter.clear();
 }
 
 void CompilerStack::setSources(StringMap const& _sources)
+{
+	SharedStringMap sources;
+	for (auto const& source: _sources)
+		sources[source.first] = make_shared<string const>(source.second);
+	setSources(sources);
+}
+
+void CompilerStack::setSources(SharedStringMap const& _sources)
 {
 	if (m_stackState == SourcesSet)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Cannot change sources once set."));
 	if (m_stackState != Empty)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set sources before parsing."));
 	for (auto const& source: _sources)
+	{
+		solAssert(source.second, "");
 		m_sources[source.first].scanner = make_shared<Scanner>(CharStream(/*content*/source.second, /*name*/source.first));
+	}
 	m_stackState = SourcesSet;
 }
 
@@ -186,22 +207,23 @@ bool CompilerStack::parse()
 	vector<string> sourcesToParse;
 	for (auto const& s: m_sources)
 		sourcesToParse.push_back(s.first);
+	// All ASTs of this compilation share an arena, which is released with the last node.
+	auto astArena = make_shared<Arena>();
 	for (size_t i = 0; i < sourcesToParse.size(); ++i)
 	{
 		string const& path = sourcesToParse[i];
 		Source& source = m_sources[path];
 		source.scanner->reset();
-		source.ast = Parser(m_errorReporter).parse(source.scanner);
+		source.ast = Parser(m_errorReporter, astArena).parse(source.scanner);
 		if (!source.ast)
 			solAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
 		else
 		{
 			source.ast->annotation().path = path;
-			for (auto const& newSource: loadMissingSources(*source.ast, path))
+			for (auto& newSource: loadMissingSources(*source.ast, path))
 			{
 				string const& newPath = newSource.first;
-				string const& newContents = newSource.second;
-				m_sources[newPath].scanner = make_shared<Scanner>(CharStream(newContents, newPath));
+				m_sources[newPath].scanner = make_shared<Scanner>(CharStream(move(newSource.second), newPath));
 				sourcesToParse.push_back(newPath);
 			}
 		}
@@ -320,25 +342,22 @@ bool CompilerStack::analyze()
 
 		if (noErrors)
 		{
-			// Checks for common mistakes. Only generates warnings.
-			StaticAnalyzer staticAnalyzer(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
-				if (!staticAnalyzer.analyze(*source->ast))
-					noErrors = false;
-		}
-
-		if (noErrors)
-		{
-			// Check for state mutability in every function.
-			vector<ASTPointer<ASTNode>> ast;
-			for (Source const* source: m_sourceOrder)
-				ast.push_back(source->ast);
-
-			if (!ViewPureChecker(ast, m_errorReporter).check())
+			// Checks for common mistakes, which only generates warnings, and checks the
+			// state mutability of every function.
+			if (!analyzeStaticallyAndCheckMutability())
 				noErrors = false;
 		}
 
-		if (noErrors)
+		// Setting up the solvers is expensive compared to compiling a small contract,
+		// so only do it if they will be used or have to warn about the given responses.
+		bool const needsSMTChecker = !m_smtlib2Responses.empty() || any_of(
+			m_sourceOrder.begin(),
+			m_sourceOrder.end(),
+			[](Source const* _source) {
+				return _source->ast->annotation().experimentalFeatures.count(ExperimentalFeature::SMTChecker);
+			}
+		);
+		if (noErrors && needsSMTChecker)
 		{
 			SMTChecker smtChecker(m_errorReporter, m_smtlib2Responses);
 			for (Source const* source: m_sourceOrder)
@@ -381,25 +400,77 @@ bool CompilerStack::compile()
 		if (!parseAndAnalyze())
 			return false;
 
+	ContractFingerprints fingerprints;
+	map<ContractDefinition const*, shared_ptr<GeneratedCode const>> reusable = reusableCode(fingerprints);
+
 	// Only compile contracts individually which have been requested.
 	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
 				if (isRequestedContract(*contract))
-					compileContract(*contract, otherCompilers);
+					compileContract(*contract, otherCompilers, reusable, fingerprints);
+
+	m_previousCode.clear();
+	for (auto const& contract: m_contracts)
+		if (contract.second.generatedCode)
+			m_previousCode[contract.first] = contract.second.generatedCode;
 	m_stackState = CompilationSuccessful;
 	this->link();
 	return true;
 }
 
+bool CompilerStack::analyzeStaticallyAndCheckMutability()
+{
+	vector<ASTPointer<ASTNode>> ast;
+	for (Source const* source: m_sourceOrder)
+		ast.push_back(source->ast);
+
+	// Both checks only read the AST, so they share a single traversal. Each reports to its
+	// own list, so that the errors are in the same order as if they ran one after the other.
+	ErrorList staticAnalyzerErrors;
+	ErrorList viewPureErrors;
+	ErrorReporter staticAnalyzerReporter(staticAnalyzerErrors);
+	ErrorReporter viewPureReporter(viewPureErrors);
+	StaticAnalyzer staticAnalyzer(staticAnalyzerReporter);
+	ViewPureChecker viewPureChecker(ast, viewPureReporter);
+	try
+	{
+		viewPureChecker.inferModifierMutability();
+		CompositeASTConstVisitor checkers({&staticAnalyzer, &viewPureChecker});
+		for (Source const* source: m_sourceOrder)
+			source->ast->accept(checkers);
+	}
+	catch (FatalError const&)
+	{
+		// Too many errors in one of the lists. Which check stops first depends on the order,
+		// so run them one after the other instead.
+		bool noErrors = true;
+		StaticAnalyzer sequentialStaticAnalyzer(m_errorReporter);
+		for (Source const* source: m_sourceOrder)
+			if (!sequentialStaticAnalyzer.analyze(*source->ast))
+				noErrors = false;
+		return noErrors && ViewPureChecker(ast, m_errorReporter).check();
+	}
+
+	m_errorReporter.merge(staticAnalyzerErrors);
+	// The mutability is only checked if the static analysis found no errors.
+	if (!Error::containsOnlyWarnings(staticAnalyzerErrors))
+		return false;
+	m_errorReporter.merge(viewPureErrors);
+	return viewPureChecker.succeeded();
+}
+
 void CompilerStack::link()
 {
 	solAssert(m_stackState >= CompilationSuccessful, "");
+	if (m_libraries.empty())
+		return;
+	eth::LinkerObject::Libraries libraries(m_libraries);
 	for (auto& contract: m_contracts)
 	{
-		contract.second.object.link(m_libraries);
-		contract.second.runtimeObject.link(m_libraries);
+		contract.second.object.link(libraries);
+		contract.second.runtimeObject.link(libraries);
 	}
 }
 
@@ -513,7 +584,7 @@ eth::LinkerObject const& CompilerStack::runtimeObject(string const& _contractNam
 }
 
 /// TODO: cache this string
-string CompilerStack::assemblyString(string const& _contractName, StringMap _sourceCodes) const
+string CompilerStack::assemblyString(string const& _contractName, SharedStringMap const& _sourceCodes) const
 {
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
@@ -526,7 +597,7 @@ string CompilerStack::assemblyString(string const& _contractName, StringMap _sou
 }
 
 /// TODO: cache the JSON
-Json::Value CompilerStack::assemblyJSON(string const& _contractName, StringMap _sourceCodes) const
+Json::Value CompilerStack::assemblyJSON(string const& _contractName, SharedStringMap const& _sourceCodes) const
 {
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
@@ -686,10 +757,21 @@ size_t CompilerStack::functionEntryPoint(
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
-	shared_ptr<Compiler> const& compiler = contract(_contractName).compiler;
+	Contract const& compiledContract = contract(_contractName);
+	shared_ptr<Compiler> const& compiler = compiledContract.compiler;
 	if (!compiler)
 		return 0;
-	eth::AssemblyItem tag = compiler->functionEntryLabel(_function);
+	// Reused code refers to the function definitions of the compilation it was generated in,
+	// which have the same source locations as the current ones.
+	FunctionDefinition const* function = &_function;
+	if (compiledContract.generatedCode && compiledContract.generatedCode->contract != compiledContract.contract)
+		for (FunctionDefinition const* previousFunction: compiledContract.generatedCode->contract->definedFunctions())
+			if (
+				previousFunction->location().start == _function.location().start &&
+				previousFunction->location().end == _function.location().end
+			)
+				function = previousFunction;
+	eth::AssemblyItem tag = compiler->functionEntryLabel(*function);
 	if (tag.type() == eth::UndefinedItem)
 		return 0;
 	eth::AssemblyItems const& items = compiler->runtimeAssemblyItems();
@@ -847,9 +929,45 @@ bool onlySafeExperimentalFeaturesActivated(set<ExperimentalFeature> const& featu
 }
 }
 
+map<ContractDefinition const*, shared_ptr<CompilerStack::GeneratedCode const>> CompilerStack::reusableCode(
+	ContractFingerprints& _fingerprints
+) const
+{
+	map<ContractDefinition const*, shared_ptr<GeneratedCode const>> reusable;
+	map<ContractDefinition const*, set<ContractDefinition const*>> createdContracts;
+	for (Source const* source: m_sourceOrder)
+		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
+			{
+				createdContracts[contract] = ContractFingerprints::createdContracts(*contract);
+				auto previous = m_previousCode.find(contract->fullyQualifiedName());
+				if (
+					previous != m_previousCode.end() &&
+					previous->second->codeFingerprint == _fingerprints.codeFingerprint(*contract)
+				)
+					reusable[contract] = previous->second;
+			}
+
+	for (bool changed = true; changed;)
+	{
+		changed = false;
+		for (auto const& contract: createdContracts)
+			for (ContractDefinition const* created: contract.second)
+				if (reusable.count(contract.first) != reusable.count(created))
+				{
+					reusable.erase(contract.first);
+					reusable.erase(created);
+					changed = true;
+				}
+	}
+	return reusable;
+}
+
 void CompilerStack::compileContract(
 	ContractDefinition const& _contract,
-	map<ContractDefinition const*, shared_ptr<Compiler const>>& _otherCompilers
+	map<ContractDefinition const*, shared_ptr<Compiler const>>& _otherCompilers,
+	map<ContractDefinition const*, shared_ptr<GeneratedCode const>> const& _reusableCode,
+	ContractFingerprints& _fingerprints
 )
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "");
@@ -857,18 +975,62 @@ void CompilerStack::compileContract(
 	if (_otherCompilers.count(&_contract) || !_contract.canBeDeployed())
 		return;
 	for (auto const* dependency: _contract.annotation().contractDependencies)
-		compileContract(*dependency, _otherCompilers);
+		compileContract(*dependency, _otherCompilers, _reusableCode, _fingerprints);
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
-	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_optimiserSettings);
-	compiledContract.compiler = compiler;
-
 	bytes cborEncodedMetadata = createCBORMetadata(
 		metadata(compiledContract),
 		!onlySafeExperimentalFeaturesActivated(_contract.sourceUnit().annotation().experimentalFeatures)
 	);
 
+	auto reusable = _reusableCode.find(&_contract);
+	if (reusable != _reusableCode.end())
+	{
+		// Only the metadata of the contract and of the contracts it creates can have changed.
+		// The metadata has a fixed size and contains a hash, so it is replaced in the bytecode.
+		auto generatedCode = make_shared<GeneratedCode>(*reusable->second);
+		map<bytes, bytes> replacements{{generatedCode->metadata, cborEncodedMetadata}};
+		set<ContractDefinition const*> created;
+		vector<ContractDefinition const*> toVisit{&_contract};
+		while (!toVisit.empty())
+		{
+			ContractDefinition const* contract = toVisit.back();
+			toVisit.pop_back();
+			for (auto const* dependency: ContractFingerprints::createdContracts(*contract))
+				if (created.insert(dependency).second)
+				{
+					toVisit.push_back(dependency);
+					compileContract(*dependency, _otherCompilers, _reusableCode, _fingerprints);
+					replacements[m_previousCode.at(dependency->fullyQualifiedName())->metadata] =
+						m_contracts.at(dependency->fullyQualifiedName()).generatedCode->metadata;
+				}
+		}
+		for (auto const& replacement: replacements)
+		{
+			solAssert(replacement.first.size() == replacement.second.size(), "");
+			for (bytes* bytecode: {&generatedCode->object.bytecode, &generatedCode->runtimeObject.bytecode})
+				for (
+					auto it = search(bytecode->begin(), bytecode->end(), replacement.first.begin(), replacement.first.end());
+					it != bytecode->end();
+					it = search(it + replacement.first.size(), bytecode->end(), replacement.first.begin(), replacement.first.end())
+				)
+					copy(replacement.second.begin(), replacement.second.end(), it);
+		}
+		generatedCode->metadata = cborEncodedMetadata;
+		generatedCode->compiler->updateMetadata(replacements);
+
+		compiledContract.generatedCode = generatedCode;
+		compiledContract.compiler = generatedCode->compiler;
+		compiledContract.object = generatedCode->object;
+		compiledContract.runtimeObject = generatedCode->runtimeObject;
+		_otherCompilers[compiledContract.contract] = generatedCode->compiler;
+		return;
+	}
+
+	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_optimiserSettings);
+	compiledContract.compiler = compiler;
+
 	try
 	{
 		// Run optimiser and compile the contract.
@@ -899,6 +1061,18 @@ void CompilerStack::compileContract(
 		solAssert(false, "Assembly exception for deployed bytecode");
 	}
 
+	auto generatedCode = make_shared<GeneratedCode>();
+	generatedCode->codeFingerprint = _fingerprints.codeFingerprint(_contract);
+	generatedCode->compiler = compiler;
+	generatedCode->object = compiledContract.object;
+	generatedCode->runtimeObject = compiledContract.runtimeObject;
+	generatedCode->metadata = cborEncodedMetadata;
+	generatedCode->contract = &_contract;
+	for (Source const* source: m_sourceOrder)
+		generatedCode->asts.push_back(source->ast);
+	compiledContract.generatedCode = generatedCode;
+	m_generatedContractNames.insert(_contract.fullyQualifiedName());
+
 	_otherCompilers[compiledContract.contract] = compiler;
 }
 
@@ -955,6 +1129,20 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 	for (auto const sourceUnit: _contract.contract->sourceUnit().referencedSourceUnits(true))
 		referencedSources.insert(sourceUnit->annotation().path);
 
+	// Hash all referenced sources that have not been hashed yet at once.
+	vector<Source const*> unhashedSources;
+	vector<bytesConstRef> unhashedContents;
+	for (auto const& s: m_sources)
+		if (referencedSources.count(s.first) && s.second.keccak256HashCached == h256{})
+		{
+			solAssert(s.second.scanner, "Scanner not available");
+			unhashedSources.push_back(&s.second);
+			unhashedContents.emplace_back(s.second.scanner->source());
+		}
+	vector<h256> hashes = dev::keccak256Many(unhashedContents);
+	for (size_t i = 0; i < unhashedSources.size(); ++i)
+		unhashedSources[i]->keccak256HashCached = hashes[i];
+
 	meta["sources"] = Json::objectValue;
 	for (auto const& s: m_sources)
 	{
@@ -1123,75 +1311,10 @@ string CompilerStack::computeSourceMapping(eth::AssemblyItems const& _items) con
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
-	string ret;
-	map<string, unsigned> sourceIndicesMap = sourceIndices();
-	int prevStart = -1;
-	int prevLength = -1;
-	int prevSourceIndex = -1;
-	char prevJump = 0;
-	for (auto const& item: _items)
-	{
-		if (!ret.empty())
-			ret += ";";
-
-		SourceLocation const& location = item.location();
-		int length = location.start != -1 && location.end != -1 ? location.end - location.start : -1;
-		int sourceIndex =
-			location.source && sourceIndicesMap.count(location.source->name()) ?
-			sourceIndicesMap.at(location.source->name()) :
-			-1;
-		char jump = '-';
-		if (item.getJumpType() == eth::AssemblyItem::JumpType::IntoFunction)
-			jump = 'i';
-		else if (item.getJumpType() == eth::AssemblyItem::JumpType::OutOfFunction)
-			jump = 'o';
-
-		unsigned components = 4;
-		if (jump == prevJump)
-		{
-			components--;
-			if (sourceIndex == prevSourceIndex)
-			{
-				components--;
-				if (length == prevLength)
-				{
-					components--;
-					if (location.start == prevStart)
-						components--;
-				}
-			}
-		}
-
-		if (components-- > 0)
-		{
-			if (location.start != prevStart)
-				ret += to_string(location.start);
-			if (components-- > 0)
-			{
-				ret += ':';
-				if (length != prevLength)
-					ret += to_string(length);
-				if (components-- > 0)
-				{
-					ret += ':';
-					if (sourceIndex != prevSourceIndex)
-						ret += to_string(sourceIndex);
-					if (components-- > 0)
-					{
-						ret += ':';
-						if (jump != prevJump)
-							ret += jump;
-					}
-				}
-			}
-		}
-
-		prevStart = location.start;
-		prevLength = length;
-		prevSourceIndex = sourceIndex;
-		prevJump = jump;
-	}
-	return ret;
+	// The sources do not change after compilation, so the indices are shared by all mappings.
+	if (!m_sourceIndices)
+		m_sourceIndices.reset(new map<string, unsigned>(sourceIndices()));
+	return eth::computeSourceMapping(_items, *m_sourceIndices);
 }
 
 namespace
@@ -1237,38 +1360,53 @@ Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 	{
 		/// External functions
 		ContractDefinition const& contract = contractDefinition(_contractName);
-		Json::Value externalFunctions(Json::objectValue);
+		vector<string> signatures;
 		for (auto it: contract.interfaceFunctions())
-		{
-			string sig = it.second->externalSignature();
-			externalFunctions[sig] = gasToJson(gasEstimator.functionalEstimation(*items, sig));
-		}
-
+			signatures.push_back(it.second->externalSignature());
+		size_t const interfaceFunctionCount = signatures.size();
 		if (contract.fallbackFunction())
 			/// This needs to be set to an invalid signature in order to trigger the fallback,
 			/// without the shortcut (of CALLDATSIZE == 0), and therefore to receive the upper bound.
 			/// An empty string ("") would work to trigger the shortcut only.
-			externalFunctions[""] = gasToJson(gasEstimator.functionalEstimation(*items, "INVALID"));
+			signatures.push_back("INVALID");
+		vector<Gas> externalGas = gasEstimator.functionalEstimations(*items, signatures);
+
+		Json::Value externalFunctions(Json::objectValue);
+		for (size_t i = 0; i < interfaceFunctionCount; ++i)
+			externalFunctions[signatures[i]] = gasToJson(externalGas[i]);
+		if (contract.fallbackFunction())
+			externalFunctions[""] = gasToJson(externalGas.back());
 
 		if (!externalFunctions.empty())
 			output["external"] = externalFunctions;
 
 		/// Internal functions
-		Json::Value internalFunctions(Json::objectValue);
+		vector<FunctionDefinition const*> functions;
+		vector<pair<size_t, FunctionDefinition const*>> entryPoints;
 		for (auto const& it: contract.definedFunctions())
 		{
 			/// Exclude externally visible functions, constructor and the fallback function
 			if (it->isPartOfExternalInterface() || it->isConstructor() || it->isFallback())
 				continue;
 
+			functions.push_back(it);
 			size_t entry = functionEntryPoint(_contractName, *it);
-			GasEstimator::GasConsumption gas = GasEstimator::GasConsumption::infinite();
 			if (entry > 0)
-				gas = gasEstimator.functionalEstimation(*items, entry, *it);
+				entryPoints.emplace_back(entry, it);
+		}
+		vector<Gas> entryPointGas = gasEstimator.functionalEstimations(*items, entryPoints);
+
+		Json::Value internalFunctions(Json::objectValue);
+		for (size_t i = 0, estimated = 0; i < functions.size(); ++i)
+		{
+			FunctionDefinition const* function = functions[i];
+			Gas gas = Gas::infinite();
+			if (estimated < entryPoints.size() && entryPoints[estimated].second == function)
+				gas = entryPointGas[estimated++];
 
 			/// TODO: This could move into a method shared with externalSignature()
-			FunctionType type(*it);
-			string sig = it->name() + "(";
+			FunctionType type(*function);
+			string sig = function->name() + "(";
 			auto paramTypes = type.parameterTypes();
 			for (auto it = paramTypes.begin(); it != paramTypes.end(); ++it)
 				sig += (*it)->toString() + (it + 1 == paramTypes.end() ? "" : ",");
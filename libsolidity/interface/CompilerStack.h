@@ -42,6 +42,7 @@
 #include <memory>
 #include <ostream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace langutil
@@ -71,6 +72,7 @@ class Compiler;
 class GlobalContext;
 class Natspec;
 class DeclarationContainer;
+class ContractFingerprints;
 
 /**
  * Easy to use and self-contained Solidity compiler with as few header dependencies as possible.
@@ -110,7 +112,9 @@ public:
 	State state() const { return m_stackState; }
 
 	/// Resets the compiler to an empty state. Unless @a _keepSettings is set to true,
-	/// all settings are reset as well.
+	/// all settings are reset as well. If they are kept, the code generated for contracts is
+	/// kept as well and reused by the next compilation for contracts whose code fingerprint
+	/// did not change.
 	void reset(bool _keepSettings = false);
 
 	// Parses a remapping of the format "context:prefix=target".
@@ -149,6 +153,9 @@ public:
 
 	/// Sets the sources. Must be set before parsing.
 	void setSources(StringMap const& _sources);
+	/// Sets the sources without copying them: the scanners only view the shared, immutable
+	/// buffers, which the caller may keep using. Must be set before parsing.
+	void setSources(SharedStringMap const& _sources);
 
 	/// Adds a response to an SMTLib2 query (identified by the hash of the query input).
 	/// Must be set before parsing.
@@ -225,12 +232,12 @@ public:
 	/// @return a verbose text representation of the assembly.
 	/// @arg _sourceCodes is the map of input files to source code strings
 	/// Prerequisite: Successful compilation.
-	std::string assemblyString(std::string const& _contractName, StringMap _sourceCodes = StringMap()) const;
+	std::string assemblyString(std::string const& _contractName, SharedStringMap const& _sourceCodes = SharedStringMap()) const;
 
 	/// @returns a JSON representation of the assembly.
 	/// @arg _sourceCodes is the map of input files to source code strings
 	/// Prerequisite: Successful compilation.
-	Json::Value assemblyJSON(std::string const& _contractName, StringMap _sourceCodes = StringMap()) const;
+	Json::Value assemblyJSON(std::string const& _contractName, SharedStringMap const& _sourceCodes = SharedStringMap()) const;
 
 	/// @returns a JSON representing the contract ABI.
 	/// Prerequisite: Successful call to parse or compile.
@@ -250,6 +257,10 @@ public:
 	/// @returns the Contract Metadata
 	std::string const& metadata(std::string const& _contractName) const;
 
+	/// @returns the fully qualified names of the contracts for which code was generated by the
+	/// last compilation, as opposed to being reused from the compilation before.
+	std::set<std::string> const& generatedContractNames() const { return m_generatedContractNames; }
+
 	/// @returns a JSON representing the estimated gas usage for contract creation, internal and external functions
 	Json::Value gasEstimates(std::string const& _contractName) const;
 
@@ -266,11 +277,26 @@ private:
 		h256 const& swarmHash() const;
 	};
 
+	/// The code generated for a contract, which is reused by later compilations
+	/// as long as its code fingerprint does not change.
+	struct GeneratedCode
+	{
+		h256 codeFingerprint;
+		std::shared_ptr<Compiler> compiler;
+		eth::LinkerObject object; ///< Unlinked deployment object.
+		eth::LinkerObject runtimeObject; ///< Unlinked runtime object.
+		bytes metadata; ///< The metadata CBOR contained in the objects.
+		/// The contract the code was generated from and the ASTs the compiler refers to.
+		ContractDefinition const* contract = nullptr;
+		std::vector<std::shared_ptr<SourceUnit>> asts;
+	};
+
 	/// The state per contract. Filled gradually during compilation.
 	struct Contract
 	{
 		ContractDefinition const* contract = nullptr;
 		std::shared_ptr<Compiler> compiler;
+		std::shared_ptr<GeneratedCode const> generatedCode;
 		eth::LinkerObject object; ///< Deployment object (includes the runtime sub-object).
 		eth::LinkerObject runtimeObject; ///< Runtime object.
 		mutable std::unique_ptr<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
@@ -281,6 +307,10 @@ private:
 		mutable std::unique_ptr<std::string const> runtimeSourceMapping;
 	};
 
+	/// Runs the static analyzer and the view/pure checker on all sources.
+	/// @returns false if any of them reported an error.
+	bool analyzeStaticallyAndCheckMutability();
+
 	/// Loads the missing sources from @a _ast (named @a _path) using the callback
 	/// @a m_readFile and stores the absolute paths of all imports in the AST annotations.
 	/// @returns the newly loaded sources.
@@ -291,12 +321,22 @@ private:
 	/// @returns true if the contract is requested to be compiled.
 	bool isRequestedContract(ContractDefinition const& _contract) const;
 
+	/// @returns the code of the previous compilation that can be reused for the contracts of
+	/// the current sources. Contracts that create each other are only reused together, since
+	/// the code of a created contract is embedded into and optimised with the creating contract.
+	std::map<ContractDefinition const*, std::shared_ptr<GeneratedCode const>> reusableCode(
+		ContractFingerprints& _fingerprints
+	) const;
+
 	/// Compile a single contract.
 	/// @param _otherCompilers provides access to compilers of other contracts, to get
 	///                        their bytecode if needed. Only filled after they have been compiled.
+	/// @param _reusableCode code of the previous compilation used instead of generating it again.
 	void compileContract(
 		ContractDefinition const& _contract,
-		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers,
+		std::map<ContractDefinition const*, std::shared_ptr<GeneratedCode const>> const& _reusableCode,
+		ContractFingerprints& _fingerprints
 	);
 
 	/// Links all the known library addresses in the available objects. Any unknown
@@ -321,7 +361,7 @@ private:
 	/// @returns the metadata CBOR for the given serialised metadata JSON.
 	static bytes createCBORMetadata(std::string const& _metadata, bool _experimentalMode);
 
-	/// @returns the computer source mapping string.
+	/// @returns the computed source mapping string.
 	std::string computeSourceMapping(eth::AssemblyItems const& _items) const;
 
 	/// @returns the contract ABI as a JSON object.
@@ -361,8 +401,14 @@ private:
 	std::shared_ptr<GlobalContext> m_globalContext;
 	std::vector<Source const*> m_sourceOrder;
 	/// This is updated during compilation.
-	std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>> m_scopes;
+	std::unordered_map<ASTNode const*, std::shared_ptr<DeclarationContainer>> m_scopes;
 	std::map<std::string const, Contract> m_contracts;
+	/// Code generated by the last successful compilation, by fully qualified contract name.
+	/// Kept across @a reset(true).
+	std::map<std::string, std::shared_ptr<GeneratedCode const>> m_previousCode;
+	std::set<std::string> m_generatedContractNames;
+	/// Source indices used by the source mappings, computed on first use.
+	mutable std::unique_ptr<std::map<std::string, unsigned> const> m_sourceIndices;
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
 	bool m_metadataLiteralSources = false;
@@ -0,0 +1,195 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Fingerprints of contracts used to decide which contracts have to be compiled again
+ * after the sources changed.
+ */
+
+#include <libsolidity/interface/ContractFingerprints.h>
+
+#include <libsolidity/interface/ABI.h>
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+
+#include <libdevcore/JSON.h>
+#include <libdevcore/Keccak256.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+namespace
+{
+
+/// Collects the contracts that declarations referenced in a contract belong to, split into
+/// those whose code is included in the contract and those it only interacts with, and the
+/// contracts it creates.
+class ReferencedContracts: private ASTConstVisitor
+{
+public:
+	explicit ReferencedContracts(ContractDefinition const& _contract)
+	{
+		_contract.accept(*this);
+	}
+
+	set<ContractDefinition const*> implementation;
+	set<ContractDefinition const*> interface;
+	set<ContractDefinition const*> created;
+
+private:
+	void endVisit(NewExpression const& _newExpression) override
+	{
+		if (auto contractType = dynamic_cast<ContractType const*>(_newExpression.typeName().annotation().type.get()))
+			created.insert(&contractType->contractDefinition());
+	}
+	void endVisit(Identifier const& _identifier) override
+	{
+		addReference(_identifier.annotation().referencedDeclaration);
+	}
+	void endVisit(MemberAccess const& _memberAccess) override
+	{
+		addReference(_memberAccess.annotation().referencedDeclaration);
+		auto magicType = dynamic_cast<MagicType const*>(_memberAccess.expression().annotation().type.get());
+		if (
+			magicType &&
+			magicType->kind() == MagicType::Kind::MetaType &&
+			(_memberAccess.memberName() == "creationCode" || _memberAccess.memberName() == "runtimeCode")
+		)
+			created.insert(&dynamic_cast<ContractType const&>(*magicType->typeArgument()).contractDefinition());
+	}
+	void endVisit(UserDefinedTypeName const& _typeName) override
+	{
+		addReference(_typeName.annotation().referencedDeclaration);
+	}
+
+	void addReference(Declaration const* _declaration)
+	{
+		if (!_declaration)
+			return;
+		if (auto contract = dynamic_cast<ContractDefinition const*>(_declaration))
+		{
+			interface.insert(contract);
+			return;
+		}
+		ASTNode const* scope = _declaration->scope();
+		while (scope && !dynamic_cast<ContractDefinition const*>(scope))
+		{
+			auto scopable = dynamic_cast<Scopable const*>(scope);
+			scope = scopable ? scopable->scope() : nullptr;
+		}
+		if (auto contract = dynamic_cast<ContractDefinition const*>(scope))
+		{
+			if (_declaration->isPartOfExternalInterface())
+				interface.insert(contract);
+			else
+				implementation.insert(contract);
+		}
+	}
+};
+
+}
+
+h256 const& ContractFingerprints::interfaceFingerprint(ContractDefinition const& _contract)
+{
+	auto it = m_interfaceFingerprints.find(&_contract);
+	if (it != m_interfaceFingerprints.end())
+		return it->second;
+
+	string data = _contract.fullyQualifiedName() + "\n" + jsonCompactPrint(ABI::generate(_contract)) + "\n";
+	for (auto const& variable: ContractType(_contract).stateVariables())
+		data +=
+			get<0>(variable)->name() + " " +
+			get<0>(variable)->annotation().type->toString(true) + " " +
+			toString(get<1>(variable)) + " " +
+			to_string(get<2>(variable)) + "\n";
+	for (FunctionDefinition const* function: _contract.definedFunctions())
+		data += function->name() + " " + FunctionType(*function).toString(false) + "\n";
+	for (ModifierDefinition const* modifier: _contract.functionModifiers())
+		data += modifier->name() + " " + ModifierType(*modifier).toString(false) + "\n";
+	for (StructDefinition const* structDefinition: _contract.definedStructs())
+	{
+		data += structDefinition->name();
+		for (auto const& member: structDefinition->members())
+			data += " " + member->name() + " " + member->annotation().type->toString(true);
+		data += "\n";
+	}
+	for (EnumDefinition const* enumDefinition: _contract.definedEnums())
+	{
+		data += enumDefinition->name();
+		for (auto const& value: enumDefinition->members())
+			data += " " + value->name();
+		data += "\n";
+	}
+	return m_interfaceFingerprints[&_contract] = keccak256(data);
+}
+
+h256 const& ContractFingerprints::implementationFingerprint(ContractDefinition const& _contract)
+{
+	auto it = m_implementationFingerprints.find(&_contract);
+	if (it != m_implementationFingerprints.end())
+		return it->second;
+
+	langutil::SourceLocation const& location = _contract.location();
+	solAssert(location.source, "");
+	string data = _contract.sourceUnitName() + "\n" + to_string(location.start) + "\n";
+	for (ExperimentalFeature feature: _contract.sourceUnit().annotation().experimentalFeatures)
+		data += to_string(unsigned(feature)) + " ";
+	data += "\n" + location.source->source().substr(location.start, location.end - location.start);
+	return m_implementationFingerprints[&_contract] = keccak256(data);
+}
+
+h256 ContractFingerprints::codeFingerprint(ContractDefinition const& _contract)
+{
+	set<ContractDefinition const*> implementation;
+	set<ContractDefinition const*> interface;
+	vector<ContractDefinition const*> toVisit{&_contract};
+	while (!toVisit.empty())
+	{
+		ContractDefinition const* contract = toVisit.back();
+		toVisit.pop_back();
+		if (!implementation.insert(contract).second)
+			continue;
+		toVisit += contract->annotation().linearizedBaseContracts;
+		toVisit += contract->annotation().contractDependencies;
+		ReferencedContracts references(*contract);
+		toVisit += references.implementation;
+		interface += references.interface;
+	}
+
+	// Sort by name so that the fingerprint does not depend on the addresses of the AST nodes.
+	map<string, h256> fingerprints;
+	for (ContractDefinition const* contract: interface)
+		if (!implementation.count(contract))
+			fingerprints["interface " + contract->fullyQualifiedName()] = interfaceFingerprint(*contract);
+	for (ContractDefinition const* contract: implementation)
+		fingerprints["implementation " + contract->fullyQualifiedName()] = implementationFingerprint(*contract);
+
+	string data;
+	for (auto const& fingerprint: fingerprints)
+		data += fingerprint.first + " " + fingerprint.second.hex() + "\n";
+	return keccak256(data);
+}
+
+set<ContractDefinition const*> ContractFingerprints::createdContracts(ContractDefinition const& _contract)
+{
+	set<ContractDefinition const*> created;
+	for (ContractDefinition const* base: _contract.annotation().linearizedBaseContracts)
+		created += ReferencedContracts(*base).created;
+	return created;
+}
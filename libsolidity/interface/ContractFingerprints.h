@@ -0,0 +1,66 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Fingerprints of contracts used to decide which contracts have to be compiled again
+ * after the sources changed.
+ */
+
+#pragma once
+
+#include <libdevcore/FixedHash.h>
+
+#include <map>
+#include <set>
+
+namespace dev
+{
+namespace solidity
+{
+
+class ContractDefinition;
+
+/**
+ * Computes and caches fingerprints of contracts of one analysed set of sources.
+ *
+ * The interface fingerprint covers everything the code of other contracts can depend on
+ * without including the code of the contract: its ABI, storage layout, the signatures of
+ * its functions and modifiers and the definitions of its structs and enums.
+ * The implementation fingerprint covers the source code of the contract, its position in
+ * the source unit and the experimental features enabled for it.
+ * The code fingerprint of a contract determines its generated code apart from the metadata:
+ * it combines the implementation fingerprints of the contract, its bases, the contracts it
+ * creates and the contracts whose internal functions or types it uses, and the interface
+ * fingerprints of all other contracts it refers to.
+ */
+class ContractFingerprints
+{
+public:
+	h256 const& interfaceFingerprint(ContractDefinition const& _contract);
+	h256 const& implementationFingerprint(ContractDefinition const& _contract);
+	h256 codeFingerprint(ContractDefinition const& _contract);
+
+	/// @returns the contracts whose code is embedded into the code of @a _contract, i.e. the
+	/// contracts created by it or by its bases and the ones whose code it accesses.
+	static std::set<ContractDefinition const*> createdContracts(ContractDefinition const& _contract);
+
+private:
+	std::map<ContractDefinition const*, h256> m_interfaceFingerprints;
+	std::map<ContractDefinition const*, h256> m_implementationFingerprints;
+};
+
+}
+}
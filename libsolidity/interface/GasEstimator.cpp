@@ -30,6 +30,7 @@
 #include <libevmasm/KnownState.h>
 #include <libevmasm/PathGasMeter.h>
 #include <libdevcore/Keccak256.h>
+#include <libdevcore/Parallel.h>
 
 #include <functional>
 #include <map>
@@ -132,6 +133,48 @@ GasEstimator::GasConsumption GasEstimator::functionalEstimation(
 	AssemblyItems const& _items,
 	string const& _signature
 ) const
+{
+	return PathGasMeter::estimateMax(_items, m_evmVersion, 0, initialState(_signature));
+}
+
+GasEstimator::GasConsumption GasEstimator::functionalEstimation(
+	AssemblyItems const& _items,
+	size_t const& _offset,
+	FunctionDefinition const& _function
+) const
+{
+	auto state = initialState(_function);
+	if (!state)
+		return GasConsumption::infinite();
+	return PathGasMeter::estimateMax(_items, m_evmVersion, _offset, state);
+}
+
+vector<GasEstimator::GasConsumption> GasEstimator::functionalEstimations(
+	AssemblyItems const& _items,
+	vector<string> const& _signatures
+) const
+{
+	vector<pair<size_t, shared_ptr<KnownState>>> starts;
+	for (string const& signature: _signatures)
+		starts.emplace_back(0, initialState(signature));
+	return estimateMax(_items, starts);
+}
+
+vector<GasEstimator::GasConsumption> GasEstimator::functionalEstimations(
+	AssemblyItems const& _items,
+	vector<pair<size_t, FunctionDefinition const*>> const& _functions
+) const
+{
+	vector<pair<size_t, shared_ptr<KnownState>>> starts;
+	for (auto const& function: _functions)
+	{
+		solAssert(function.second, "");
+		starts.emplace_back(function.first, initialState(*function.second));
+	}
+	return estimateMax(_items, starts);
+}
+
+shared_ptr<KnownState> GasEstimator::initialState(string const& _signature) const
 {
 	auto state = make_shared<KnownState>();
 
@@ -164,29 +207,39 @@ GasEstimator::GasConsumption GasEstimator::functionalEstimation(
 		);
 	}
 
-	return PathGasMeter::estimateMax(_items, m_evmVersion, 0, state);
+	return state;
 }
 
-GasEstimator::GasConsumption GasEstimator::functionalEstimation(
-	AssemblyItems const& _items,
-	size_t const& _offset,
-	FunctionDefinition const& _function
-) const
+shared_ptr<KnownState> GasEstimator::initialState(FunctionDefinition const& _function) const
 {
-	auto state = make_shared<KnownState>();
-
 	unsigned parametersSize = CompilerUtils::sizeOnStack(_function.parameters());
 	if (parametersSize > 16)
-		return GasConsumption::infinite();
+		return nullptr;
 
+	auto state = make_shared<KnownState>();
 	// Store an invalid return value on the stack, so that the path estimator breaks upon reaching
 	// the return jump.
 	AssemblyItem invalidTag(PushTag, u256(-0x10));
 	state->feedItem(invalidTag, true);
 	if (parametersSize > 0)
 		state->feedItem(swapInstruction(parametersSize));
+	return state;
+}
 
-	return PathGasMeter::estimateMax(_items, m_evmVersion, _offset, state);
+vector<GasEstimator::GasConsumption> GasEstimator::estimateMax(
+	AssemblyItems const& _items,
+	vector<pair<size_t, shared_ptr<KnownState>>> const& _starts
+) const
+{
+	// The states are built beforehand because building them touches the AST. Each estimation
+	// only works on its own copy of its state, so they can run concurrently.
+	vector<GasConsumption> gas(_starts.size(), GasConsumption::infinite());
+	parallelFor(_starts.size(), [&](size_t _i)
+	{
+		if (_starts[_i].second)
+			gas[_i] = PathGasMeter::estimateMax(_items, m_evmVersion, _starts[_i].first, _starts[_i].second);
+	});
+	return gas;
 }
 
 set<ASTNode const*> GasEstimator::finestNodesAtLocation(
@@ -29,10 +29,15 @@
 
 #include <array>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace dev
 {
+namespace eth
+{
+class KnownState;
+}
 namespace solidity
 {
 
@@ -81,7 +86,33 @@ public:
 		FunctionDefinition const& _function
 	) const;
 
+	/// @returns the estimated gas consumption by each of the (public or external) functions with
+	/// the given signatures, in the same order. The estimations run concurrently.
+	std::vector<GasConsumption> functionalEstimations(
+		eth::AssemblyItems const& _items,
+		std::vector<std::string> const& _signatures
+	) const;
+
+	/// @returns the estimated gas consumption by each of the given functions, which start at the
+	/// given offsets into the list of assembly items, in the same order. The estimations run concurrently.
+	/// @note this does not work correctly for recursive functions.
+	std::vector<GasConsumption> functionalEstimations(
+		eth::AssemblyItems const& _items,
+		std::vector<std::pair<size_t, FunctionDefinition const*>> const& _functions
+	) const;
+
 private:
+	/// @returns the state at the start of the contract if it is called with the given signature.
+	std::shared_ptr<eth::KnownState> initialState(std::string const& _signature) const;
+	/// @returns the state at the entry of the given function or nullptr if it cannot be estimated.
+	std::shared_ptr<eth::KnownState> initialState(FunctionDefinition const& _function) const;
+	/// Runs the path gas meter from each of the given offsets and states concurrently.
+	/// A null state is estimated as infinite.
+	std::vector<GasConsumption> estimateMax(
+		eth::AssemblyItems const& _items,
+		std::vector<std::pair<size_t, std::shared_ptr<eth::KnownState>>> const& _starts
+	) const;
+
 	/// @returns the set of AST nodes which are the finest nodes at their location.
 	static std::set<ASTNode const*> finestNodesAtLocation(std::vector<ASTNode const*> const& _roots);
 	langutil::EVMVersion m_evmVersion;
@@ -33,6 +33,7 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/optional.hpp>
 #include <algorithm>
+#include <sstream>
 
 using namespace std;
 using namespace dev;
@@ -100,22 +101,6 @@ Json::Value formatErrorWithException(
 	return formatError(_warning, _type, _component, message, formattedMessage, sourceLocation);
 }
 
-set<string> requestedContractNames(Json::Value const& _outputSelection)
-{
-	set<string> names;
-	for (auto const& sourceName: _outputSelection.getMemberNames())
-	{
-		for (auto const& contractName: _outputSelection[sourceName].getMemberNames())
-		{
-			/// Consider the "all sources" shortcuts as requesting everything.
-			if (contractName == "*" || contractName == "")
-				return set<string>();
-			names.insert((sourceName == "*" ? "" : sourceName) + ":" + contractName);
-		}
-	}
-	return names;
-}
-
 /// Returns true iff @a _hash (hex with 0x prefix) is the Keccak256 hash of the binary data in @a _content.
 bool hashMatchesContent(string const& _hash, string const& _content)
 {
@@ -184,28 +169,93 @@ bool isArtifactRequested(Json::Value const& _outputSelection, string const& _fil
 	return false;
 }
 
-/// @returns true if any binary was requested, i.e. we actually have to perform compilation.
-bool isBinaryRequested(Json::Value const& _outputSelection)
+/// Contract-level artifacts of the output selection, as bits of a bitmask.
+enum ContractArtifact: unsigned
+{
+	ABI = 1 << 0,
+	Metadata = 1 << 1,
+	UserDoc = 1 << 2,
+	DevDoc = 1 << 3,
+	Assembly = 1 << 4,
+	LegacyAssembly = 1 << 5,
+	MethodIdentifiers = 1 << 6,
+	GasEstimates = 1 << 7,
+	Bytecode = 1 << 8,
+	DeployedBytecode = 1 << 9,
+	AllArtifacts = (1 << 10) - 1,
+	/// Artifacts that can only be produced by running code generation (and the optimiser).
+	ArtifactsRequiringCompilation = Assembly | LegacyAssembly | GasEstimates | Bytecode | DeployedBytecode
+};
+
+/// @returns the bitmask of the artifacts requested by the array @a _artifacts of an output selection.
+unsigned contractArtifacts(Json::Value const& _artifacts)
+{
+	static map<string, unsigned> const artifactBits{
+		{"*", AllArtifacts},
+		{"abi", ABI},
+		{"metadata", Metadata},
+		{"userdoc", UserDoc},
+		{"devdoc", DevDoc},
+		{"evm.assembly", Assembly},
+		{"evm.legacyAssembly", LegacyAssembly},
+		{"evm.methodIdentifiers", MethodIdentifiers},
+		{"evm.gasEstimates", GasEstimates},
+		{"evm.bytecode", Bytecode},
+		{"evm.bytecode.object", Bytecode},
+		{"evm.bytecode.opcodes", Bytecode},
+		{"evm.bytecode.sourceMap", Bytecode},
+		{"evm.bytecode.linkReferences", Bytecode},
+		{"evm.deployedBytecode", DeployedBytecode},
+		{"evm.deployedBytecode.object", DeployedBytecode},
+		{"evm.deployedBytecode.opcodes", DeployedBytecode},
+		{"evm.deployedBytecode.sourceMap", DeployedBytecode},
+		{"evm.deployedBytecode.linkReferences", DeployedBytecode}
+	};
+
+	unsigned artifacts = 0;
+	if (_artifacts.isArray())
+		for (auto const& artifact: _artifacts)
+			if (artifact.isString())
+			{
+				auto it = artifactBits.find(artifact.asString());
+				if (it != artifactBits.end())
+					artifacts |= it->second;
+			}
+	return artifacts;
+}
+
+/// Flattens @a _outputSelection into the bitmask of requested artifacts for each of the
+/// fully qualified @a _contractNames, taking wildcards for file and contract names into account.
+/// This replaces repeated calls to isArtifactRequested once the contracts are known.
+map<string, unsigned> contractRequirements(Json::Value const& _outputSelection, vector<string> const& _contractNames)
 {
+	map<string, unsigned> requirements;
 	if (!_outputSelection.isObject())
-		return false;
+		return requirements;
 
-	// This does not inculde "evm.methodIdentifiers" on purpose!
-	static vector<string> const outputsThatRequireBinaries{
-		"*",
-		"evm.deployedBytecode", "evm.deployedBytecode.object", "evm.deployedBytecode.opcodes",
-		"evm.deployedBytecode.sourceMap", "evm.deployedBytecode.linkReferences",
-		"evm.bytecode", "evm.bytecode.object", "evm.bytecode.opcodes", "evm.bytecode.sourceMap",
-		"evm.bytecode.linkReferences",
-		"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly"
-	};
+	// Cache the selections by file, as many contracts usually share the same source.
+	map<string, unsigned> wildcardContractInFile;
+	for (string const& contractName: _contractNames)
+	{
+		size_t colon = contractName.rfind(':');
+		solAssert(colon != string::npos, "");
+		string file = contractName.substr(0, colon);
+		string name = contractName.substr(colon + 1);
 
-	for (auto const& fileRequests: _outputSelection)
-		for (auto const& requests: fileRequests)
-			for (auto const& output: outputsThatRequireBinaries)
-				if (isArtifactRequested(requests, output))
-					return true;
-	return false;
+		unsigned& artifacts = requirements[contractName];
+		for (auto const& selectedFile: { file, string("*") })
+			if (_outputSelection.isMember(selectedFile) && _outputSelection[selectedFile].isObject())
+			{
+				Json::Value const& fileSelection = _outputSelection[selectedFile];
+				if (fileSelection.isMember(name))
+					artifacts |= contractArtifacts(fileSelection[name]);
+				if (!wildcardContractInFile.count(selectedFile))
+					wildcardContractInFile[selectedFile] =
+						fileSelection.isMember("*") ? contractArtifacts(fileSelection["*"]) : 0;
+				artifacts |= wildcardContractInFile[selectedFile];
+			}
+	}
+	return requirements;
 }
 
 Json::Value formatLinkReferences(std::map<size_t, std::string> const& linkReferences)
@@ -220,16 +270,12 @@ Json::Value formatLinkReferences(std::map<size_t, std::string> const& linkRefere
 		string file = fullname.substr(0, colon);
 		string name = fullname.substr(colon + 1);
 
-		Json::Value fileObject = ret.get(file, Json::objectValue);
-		Json::Value libraryArray = fileObject.get(name, Json::arrayValue);
-
 		Json::Value entry = Json::objectValue;
 		entry["start"] = Json::UInt(ref.first);
 		entry["length"] = 20;
 
-		libraryArray.append(entry);
-		fileObject[name] = libraryArray;
-		ret[file] = fileObject;
+		// Append in place instead of copying the objects of the file and the library per reference.
+		ret[file][name].append(entry);
 	}
 
 	return ret;
@@ -642,12 +688,16 @@ boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompile
 	return std::move(ret);
 }
 
-Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings, string* _serialisedOutput)
 {
 	CompilerStack compilerStack(m_readFile);
 
-	StringMap sourceList = std::move(_inputsAndSettings.sources);
-	compilerStack.setSources(sourceList);
+	// The compiler stack only views the sources, so that they are not held twice.
+	SharedStringMap sources;
+	for (auto& source: _inputsAndSettings.sources)
+		sources[source.first] = make_shared<string const>(std::move(source.second));
+	_inputsAndSettings.sources.clear();
+	compilerStack.setSources(sources);
 	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
 		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
 	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
@@ -655,18 +705,30 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
 	compilerStack.setLibraries(_inputsAndSettings.libraries);
 	compilerStack.useMetadataLiteralSources(_inputsAndSettings.metadataLiteralSources);
-	compilerStack.setRequestedContractNames(requestedContractNames(_inputsAndSettings.outputSelection));
 
 	Json::Value errors = std::move(_inputsAndSettings.errors);
 
-	bool const binariesRequested = isBinaryRequested(_inputsAndSettings.outputSelection);
+	map<string, unsigned> requirements;
+	bool binariesRequested = false;
 
 	try
 	{
-		if (binariesRequested)
-			compilerStack.compile();
-		else
-			compilerStack.parseAndAnalyze();
+		if (compilerStack.parseAndAnalyze())
+		{
+			// Only run code generation and the optimiser for contracts whose compilation
+			// artifacts were requested. Their dependencies are compiled by the compiler stack.
+			requirements = contractRequirements(_inputsAndSettings.outputSelection, compilerStack.contractNames());
+			set<string> contractsToCompile;
+			for (auto const& requirement: requirements)
+				if (requirement.second & ArtifactsRequiringCompilation)
+					contractsToCompile.insert(requirement.first);
+			if (!contractsToCompile.empty())
+			{
+				binariesRequested = true;
+				compilerStack.setRequestedContractNames(contractsToCompile);
+				compilerStack.compile();
+			}
+		}
 
 		for (auto const& error: compilerStack.errors())
 		{
@@ -767,19 +829,6 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		for (string const& query: compilerStack.unhandledSMTLib2Queries())
 			output["auxiliaryInputRequested"]["smtlib2queries"]["0x" + keccak256(query).hex()] = query;
 
-	output["sources"] = Json::objectValue;
-	unsigned sourceIndex = 0;
-	for (string const& sourceName: analysisSuccess ? compilerStack.sourceNames() : vector<string>())
-	{
-		Json::Value sourceResult = Json::objectValue;
-		sourceResult["id"] = sourceIndex++;
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast"))
-			sourceResult["ast"] = ASTJsonConverter(false, compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "legacyAST"))
-			sourceResult["legacyAST"] = ASTJsonConverter(true, compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
-		output["sources"][sourceName] = sourceResult;
-	}
-
 	Json::Value contractsOutput = Json::objectValue;
 	for (string const& contractName: analysisSuccess ? compilerStack.contractNames() : vector<string>())
 	{
@@ -788,46 +837,38 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		string file = contractName.substr(0, colon);
 		string name = contractName.substr(colon + 1);
 
+		unsigned const artifacts = requirements[contractName];
+
 		// ABI, documentation and metadata
 		Json::Value contractData(Json::objectValue);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi"))
+		if (artifacts & ABI)
 			contractData["abi"] = compilerStack.contractABI(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata"))
+		if (artifacts & Metadata)
 			contractData["metadata"] = compilerStack.metadata(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc"))
+		if (artifacts & UserDoc)
 			contractData["userdoc"] = compilerStack.natspecUser(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc"))
+		if (artifacts & DevDoc)
 			contractData["devdoc"] = compilerStack.natspecDev(contractName);
 
 		// EVM
 		Json::Value evmData(Json::objectValue);
 		// @TODO: add ir
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly"))
-			evmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly"))
-			evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName, sourceList);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers"))
+		if (compilationSuccess && (artifacts & Assembly))
+			evmData["assembly"] = compilerStack.assemblyString(contractName, sources);
+		if (compilationSuccess && (artifacts & LegacyAssembly))
+			evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName, sources);
+		if (artifacts & MethodIdentifiers)
 			evmData["methodIdentifiers"] = compilerStack.methodIdentifiers(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates"))
+		if (compilationSuccess && (artifacts & GasEstimates))
 			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
 
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			{ "evm.bytecode", "evm.bytecode.object", "evm.bytecode.opcodes", "evm.bytecode.sourceMap", "evm.bytecode.linkReferences" }
-		))
+		if (compilationSuccess && (artifacts & Bytecode))
 			evmData["bytecode"] = collectEVMObject(
 				compilerStack.object(contractName),
 				compilerStack.sourceMapping(contractName)
 			);
 
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			{ "evm.deployedBytecode", "evm.deployedBytecode.object", "evm.deployedBytecode.opcodes", "evm.deployedBytecode.sourceMap", "evm.deployedBytecode.linkReferences" }
-		))
+		if (compilationSuccess && (artifacts & DeployedBytecode))
 			evmData["deployedBytecode"] = collectEVMObject(
 				compilerStack.runtimeObject(contractName),
 				compilerStack.runtimeSourceMapping(contractName)
@@ -846,7 +887,55 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	if (!contractsOutput.empty())
 		output["contracts"] = contractsOutput;
 
-	return output;
+	vector<string> const sourceNames = analysisSuccess ? compilerStack.sourceNames() : vector<string>();
+	if (!_serialisedOutput)
+	{
+		output["sources"] = Json::objectValue;
+		unsigned sourceIndex = 0;
+		for (string const& sourceName: sourceNames)
+		{
+			Json::Value sourceResult = Json::objectValue;
+			sourceResult["id"] = sourceIndex++;
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast"))
+				sourceResult["ast"] = ASTJsonConverter(false, compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "legacyAST"))
+				sourceResult["legacyAST"] = ASTJsonConverter(true, compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
+			output["sources"][sourceName] = sourceResult;
+		}
+		return output;
+	}
+
+	// The members are printed sorted by name and "sources" comes last, so it can be appended
+	// to the rest of the serialised output. This way, the ASTs are written while visiting
+	// and never held as Json::Value trees.
+	for (string const& member: output.getMemberNames())
+		solAssert(member < "sources", "");
+	string const rest = jsonCompactPrint(output);
+	ostringstream serialised;
+	serialised << rest.substr(0, rest.size() - 1) << (output.empty() ? "" : ",") << "\"sources\":{";
+	unsigned sourceIndex = 0;
+	for (string const& sourceName: sourceNames)
+	{
+		if (sourceIndex != 0)
+			serialised << ",";
+		serialised << Json::valueToQuotedString(sourceName.c_str()) << ":{";
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast"))
+		{
+			serialised << "\"ast\":";
+			ASTJsonConverter(false, compilerStack.sourceIndices()).printCompact(serialised, compilerStack.ast(sourceName));
+			serialised << ",";
+		}
+		serialised << "\"id\":" << sourceIndex++;
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "legacyAST"))
+		{
+			serialised << ",\"legacyAST\":";
+			ASTJsonConverter(true, compilerStack.sourceIndices()).printCompact(serialised, compilerStack.ast(sourceName));
+		}
+		serialised << "}";
+	}
+	serialised << "}}";
+	*_serialisedOutput = serialised.str();
+	return Json::nullValue;
 }
 
 
@@ -925,6 +1014,11 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
+{
+	return compile(_input, nullptr);
+}
+
+Json::Value StandardCompiler::compile(Json::Value const& _input, string* _serialisedOutput) noexcept
 {
 	try
 	{
@@ -933,7 +1027,7 @@ Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 			return boost::get<Json::Value>(std::move(parsed));
 		InputsAndSettings settings = boost::get<InputsAndSettings>(std::move(parsed));
 		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
+			return compileSolidity(std::move(settings), _serialisedOutput);
 		else if (settings.language == "Yul")
 			return compileYul(std::move(settings));
 		else
@@ -972,12 +1066,13 @@ string StandardCompiler::compile(string const& _input) noexcept
 	}
 
 	// cout << "Input: " << input.toStyledString() << endl;
-	Json::Value output = compile(input);
+	string serialisedOutput;
+	Json::Value output = compile(input, &serialisedOutput);
 	// cout << "Output: " << output.toStyledString() << endl;
 
 	try
 	{
-		return jsonCompactPrint(output);
+		return output.isNull() ? serialisedOutput : jsonCompactPrint(output);
 	}
 	catch (...)
 	{
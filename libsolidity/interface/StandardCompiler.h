@@ -74,7 +74,13 @@ private:
 	/// it in condensed form or an error as a json object.
 	boost::variant<InputsAndSettings, Json::Value> parseInput(Json::Value const& _input);
 
-	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
+	/// Like the public overload, but if @a _serialisedOutput is not null, the output may also be
+	/// serialised into it directly, in which case a null value is returned.
+	Json::Value compile(Json::Value const& _input, std::string* _serialisedOutput) noexcept;
+
+	/// Compiles Solidity sources. If @a _serialisedOutput is not null, the output is serialised
+	/// into it and a null value is returned, unless the compilation was aborted.
+	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings, std::string* _serialisedOutput = nullptr);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
@@ -62,7 +62,11 @@ public:
 		solAssert(m_location.source, "");
 		if (m_location.end < 0)
 			markEndPosition();
-		return make_shared<NodeType>(m_location, std::forward<Args>(_args)...);
+		return allocate_shared<NodeType>(
+			ArenaAllocator<NodeType>(m_parser.m_arena),
+			m_location,
+			std::forward<Args>(_args)...
+		);
 	}
 
 	SourceLocation const& location() const noexcept { return m_location; }
@@ -175,7 +179,7 @@ ASTPointer<ImportDirective> Parser::parseImportDirective()
 	ASTNodeFactory nodeFactory(*this);
 	expectToken(Token::Import);
 	ASTPointer<ASTString> path;
-	ASTPointer<ASTString> unitAlias = make_shared<string>();
+	ASTPointer<ASTString> unitAlias = createString();
 	vector<pair<ASTPointer<Identifier>, ASTPointer<ASTString>>> symbolAliases;
 
 	if (m_scanner->currentToken() == Token::StringLiteral)
@@ -259,7 +263,7 @@ ASTPointer<ContractDefinition> Parser::parseContractDefinition()
 	ASTNodeFactory nodeFactory(*this);
 	ASTPointer<ASTString> docString;
 	if (m_scanner->currentCommentLiteral() != "")
-		docString = make_shared<ASTString>(m_scanner->currentCommentLiteral());
+		docString = createString(m_scanner->currentCommentLiteral());
 	ContractDefinition::ContractKind contractKind = parseContractKind();
 	ASTPointer<ASTString> name = expectIdentifierToken();
 	vector<ASTPointer<InheritanceSpecifier>> baseContracts;
@@ -403,9 +407,9 @@ Parser::FunctionHeaderParserResult Parser::parseFunctionHeader(bool _forceEmptyN
 	m_scanner->next();
 
 	if (result.isConstructor)
-		result.name = make_shared<ASTString>();
+		result.name = createString();
 	else if (_forceEmptyName || m_scanner->currentToken() == Token::LParen)
-		result.name = make_shared<ASTString>();
+		result.name = createString();
 	else if (m_scanner->currentToken() == Token::Constructor)
 		fatalParserError(string(
 			"This function is named \"constructor\" but is not the constructor of the contract. "
@@ -491,7 +495,7 @@ ASTPointer<ASTNode> Parser::parseFunctionDefinitionOrFunctionTypeStateVariable()
 	ASTNodeFactory nodeFactory(*this);
 	ASTPointer<ASTString> docstring;
 	if (m_scanner->currentCommentLiteral() != "")
-		docstring = make_shared<ASTString>(m_scanner->currentCommentLiteral());
+		docstring = createString(m_scanner->currentCommentLiteral());
 
 	FunctionHeaderParserResult header = parseFunctionHeader(false, true);
 
@@ -676,7 +680,7 @@ ASTPointer<VariableDeclaration> Parser::parseVariableDeclaration(
 
 	if (_options.allowEmptyName && m_scanner->currentToken() != Token::Identifier)
 	{
-		identifier = make_shared<ASTString>("");
+		identifier = createString();
 		solAssert(!_options.allowVar, ""); // allowEmptyName && allowVar makes no sense
 	}
 	else
@@ -715,7 +719,7 @@ ASTPointer<ModifierDefinition> Parser::parseModifierDefinition()
 	ASTNodeFactory nodeFactory(*this);
 	ASTPointer<ASTString> docstring;
 	if (m_scanner->currentCommentLiteral() != "")
-		docstring = make_shared<ASTString>(m_scanner->currentCommentLiteral());
+		docstring = createString(m_scanner->currentCommentLiteral());
 
 	expectToken(Token::Modifier);
 	ASTPointer<ASTString> name(expectIdentifierToken());
@@ -740,7 +744,7 @@ ASTPointer<EventDefinition> Parser::parseEventDefinition()
 	ASTNodeFactory nodeFactory(*this);
 	ASTPointer<ASTString> docstring;
 	if (m_scanner->currentCommentLiteral() != "")
-		docstring = make_shared<ASTString>(m_scanner->currentCommentLiteral());
+		docstring = createString(m_scanner->currentCommentLiteral());
 
 	expectToken(Token::Event);
 	ASTPointer<ASTString> name(expectIdentifierToken());
@@ -970,7 +974,7 @@ ASTPointer<Statement> Parser::parseStatement()
 	RecursionGuard recursionGuard(*this);
 	ASTPointer<ASTString> docString;
 	if (m_scanner->currentCommentLiteral() != "")
-		docString = make_shared<ASTString>(m_scanner->currentCommentLiteral());
+		docString = createString(m_scanner->currentCommentLiteral());
 	ASTPointer<Statement> statement;
 	switch (m_scanner->currentToken())
 	{
@@ -1564,7 +1568,7 @@ ASTPointer<Expression> Parser::parsePrimaryExpression()
 		// Inside expressions "type" is the name of a special, globally-available function.
 		nodeFactory.markEndPosition();
 		m_scanner->next();
-		expression = nodeFactory.createNode<Identifier>(make_shared<ASTString>("type"));
+		expression = nodeFactory.createNode<Identifier>(createString("type"));
 		break;
 	case Token::LParen:
 	case Token::LBrack:
@@ -1789,7 +1793,7 @@ ASTPointer<Expression> Parser::expressionFromIndexAccessStructure(
 		Identifier const& identifier = dynamic_cast<Identifier const&>(*_iap.path[i]);
 		expression = nodeFactory.createNode<MemberAccess>(
 			expression,
-			make_shared<ASTString>(identifier.name())
+			createString(identifier.name())
 		);
 	}
 	for (auto const& index: _iap.indices)
@@ -1808,6 +1812,11 @@ ASTPointer<ParameterList> Parser::createEmptyParameterList()
 	return nodeFactory.createNode<ParameterList>(vector<ASTPointer<VariableDeclaration>>());
 }
 
+ASTPointer<ASTString> Parser::createString(string _value) const
+{
+	return allocate_shared<ASTString>(ArenaAllocator<ASTString>(m_arena), move(_value));
+}
+
 ASTPointer<ASTString> Parser::expectIdentifierToken()
 {
 	// do not advance on success
@@ -1817,7 +1826,7 @@ ASTPointer<ASTString> Parser::expectIdentifierToken()
 
 ASTPointer<ASTString> Parser::getLiteralAndAdvance()
 {
-	ASTPointer<ASTString> identifier = make_shared<ASTString>(m_scanner->currentLiteral());
+	ASTPointer<ASTString> identifier = createString(m_scanner->currentLiteral());
 	m_scanner->next();
 	return identifier;
 }
@@ -24,6 +24,7 @@
 
 #include <libsolidity/ast/AST.h>
 #include <liblangutil/ParserBase.h>
+#include <libdevcore/Arena.h>
 
 namespace langutil
 {
@@ -38,7 +39,15 @@ namespace solidity
 class Parser: public langutil::ParserBase
 {
 public:
-	explicit Parser(langutil::ErrorReporter& _errorReporter): ParserBase(_errorReporter) {}
+	/// Creates a parser that allocates the nodes of the AST and their strings in @a _arena.
+	/// The arena is kept alive by the nodes and can be shared between the parsers of a compilation.
+	explicit Parser(
+		langutil::ErrorReporter& _errorReporter,
+		std::shared_ptr<dev::Arena> _arena = std::make_shared<dev::Arena>()
+	):
+		ParserBase(_errorReporter),
+		m_arena(std::move(_arena))
+	{}
 
 	ASTPointer<SourceUnit> parse(std::shared_ptr<langutil::Scanner> const& _scanner);
 
@@ -178,9 +187,13 @@ private:
 
 	/// Creates an empty ParameterList at the current location (used if parameters can be omitted).
 	ASTPointer<ParameterList> createEmptyParameterList();
+	/// Creates a string in the arena of the AST.
+	ASTPointer<ASTString> createString(std::string _value = std::string()) const;
 
 	/// Flag that signifies whether '_' is parsed as a PlaceholderStatement or a regular identifier.
 	bool m_insideModifier = false;
+	/// Memory for the nodes of the AST and their strings.
+	std::shared_ptr<dev::Arena> m_arena;
 };
 
 }
@@ -145,7 +145,9 @@ void AssemblyStack::optimize(Object& _object)
 		languageToDialect(m_language, m_evmVersion),
 		*_object.code,
 		*_object.analysisInfo,
-		m_optimiserSettings.optimizeStackAllocation
+		m_optimiserSettings.optimizeStackAllocation,
+		{},
+		m_optimiserSettings.expectedExecutionsPerDeployment
 	);
 }
 
@@ -22,6 +22,7 @@
 
 #include <boost/noncopyable.hpp>
 
+#include <functional>
 #include <unordered_map>
 #include <memory>
 #include <vector>
@@ -43,6 +44,16 @@ public:
 		std::uint64_t hash;
 	};
 
+	/// Registers a function that is called whenever the repository is reset.
+	/// Used by process-wide caches that hold YulStrings and have to drop them.
+	struct ResetCallback
+	{
+		explicit ResetCallback(std::function<void()> _function)
+		{
+			YulStringRepository::resetCallbacks().emplace_back(std::move(_function));
+		}
+	};
+
 	YulStringRepository() = default;
 
 	static YulStringRepository& instance()
@@ -50,6 +61,20 @@ public:
 		static YulStringRepository inst;
 		return inst;
 	}
+	/// Removes all strings except the empty string and invokes all reset callbacks.
+	/// All YulStrings created before become invalid, so this may only be called while
+	/// no YulString is in use, e.g. between two inputs of a long-running fuzzer.
+	void reset()
+	{
+		for (auto const& callback: resetCallbacks())
+			callback();
+		m_strings.clear();
+		m_hashToID.clear();
+		m_strings.emplace_back(std::make_shared<std::string>());
+		m_hashToID.emplace(emptyHash(), 0);
+	}
+	/// @returns the number of strings in the repository, including the empty string.
+	size_t size() const { return m_strings.size(); }
 	Handle stringToHandle(std::string const& _string)
 	{
 		if (_string.empty())
@@ -81,6 +106,12 @@ public:
 	static constexpr std::uint64_t emptyHash() { return 14695981039346656037u; }
 
 private:
+	static std::vector<std::function<void()>>& resetCallbacks()
+	{
+		static std::vector<std::function<void()>> callbacks;
+		return callbacks;
+	}
+
 	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
 	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
 };
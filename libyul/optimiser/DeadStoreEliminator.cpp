@@ -0,0 +1,309 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimiser component that removes stores to memory and storage whose effect is never observed.
+ */
+
+#include <libyul/optimiser/DeadStoreEliminator.h>
+
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SSAValueTracker.h>
+#include <libyul/AsmData.h>
+#include <libyul/Dialect.h>
+#include <libyul/Utilities.h>
+
+#include <libdevcore/CommonData.h>
+
+using namespace std;
+using namespace dev;
+using namespace yul;
+
+namespace
+{
+
+/// Determines whether the visited code uses msize.
+class MSizeFinder: public ASTWalker
+{
+public:
+	using ASTWalker::operator();
+	void operator()(FunctionalInstruction const& _instruction) override
+	{
+		if (_instruction.instruction == eth::Instruction::MSIZE)
+			m_usesMSize = true;
+		ASTWalker::operator()(_instruction);
+	}
+
+	bool usesMSize() const { return m_usesMSize; }
+
+private:
+	bool m_usesMSize = false;
+};
+
+}
+
+void DeadStoreEliminator::run(Dialect const& _dialect, Block& _ast)
+{
+	SSAValueTracker ssaValues;
+	ssaValues(_ast);
+	MSizeFinder msizeFinder;
+	msizeFinder(_ast);
+	DeadStoreEliminator{_dialect, ssaValues.values(), msizeFinder.usesMSize()}(_ast);
+}
+
+DeadStoreEliminator::DeadStoreEliminator(
+	Dialect const& _dialect,
+	map<YulString, Expression const*> _ssaValues,
+	bool _usesMSize
+):
+	m_dialect(_dialect),
+	m_ssaValues(std::move(_ssaValues)),
+	m_usesMSize(_usesMSize)
+{
+}
+
+void DeadStoreEliminator::operator()(Block& _block)
+{
+	ASTModifier::operator()(_block);
+
+	vector<bool> dead(_block.statements.size(), false);
+	for (size_t i = 0; i < _block.statements.size(); ++i)
+		if (boost::optional<Store> store = storeIn(_block.statements[i]))
+			for (size_t j = i + 1; j < _block.statements.size(); ++j)
+			{
+				Effect effect = effectOn(*store, _block.statements[j]);
+				if (effect == Effect::None)
+					continue;
+				dead[i] = (effect == Effect::Overwrites || effect == Effect::Discards);
+				break;
+			}
+
+	size_t index = 0;
+	iterateReplacing(
+		_block.statements,
+		[&](Statement&) -> boost::optional<vector<Statement>>
+		{
+			if (dead[index++])
+				return vector<Statement>{};
+			return {};
+		}
+	);
+}
+
+boost::optional<DeadStoreEliminator::Store> DeadStoreEliminator::storeIn(Statement const& _statement) const
+{
+	if (_statement.type() != typeid(ExpressionStatement))
+		return {};
+	Expression const& expression = boost::get<ExpressionStatement>(_statement).expression;
+	if (expression.type() != typeid(FunctionalInstruction))
+		return {};
+	auto const& instruction = boost::get<FunctionalInstruction>(expression);
+	for (Expression const& argument: instruction.arguments)
+		if (!MovableChecker{m_dialect, argument}.movable())
+			return {};
+	switch (instruction.instruction)
+	{
+	case eth::Instruction::SSTORE:
+		return Store{true, &instruction.arguments.at(0), 1};
+	case eth::Instruction::MSTORE:
+		if (!m_usesMSize)
+			return Store{false, &instruction.arguments.at(0), 32};
+		break;
+	case eth::Instruction::MSTORE8:
+		if (!m_usesMSize)
+			return Store{false, &instruction.arguments.at(0), 1};
+		break;
+	default:
+		break;
+	}
+	return {};
+}
+
+DeadStoreEliminator::Effect DeadStoreEliminator::effectOn(Store const& _store, Statement const& _statement) const
+{
+	if (_statement.type() == typeid(ExpressionStatement))
+		return effectOn(_store, boost::get<ExpressionStatement>(_statement).expression, true);
+	else if (_statement.type() == typeid(VariableDeclaration))
+	{
+		auto const& varDecl = boost::get<VariableDeclaration>(_statement);
+		return varDecl.value ? effectOn(_store, *varDecl.value) : Effect::None;
+	}
+	else if (_statement.type() == typeid(Assignment))
+		return effectOn(_store, *boost::get<Assignment>(_statement).value);
+	// Control flow, which is not followed.
+	return Effect::Observes;
+}
+
+DeadStoreEliminator::Effect DeadStoreEliminator::effectOn(
+	Store const& _store,
+	Expression const& _expression,
+	bool _topLevel
+) const
+{
+	if (_expression.type() == typeid(FunctionalInstruction))
+		return effectOn(_store, boost::get<FunctionalInstruction>(_expression), _topLevel);
+	else if (_expression.type() == typeid(FunctionCall))
+	{
+		auto const& functionCall = boost::get<FunctionCall>(_expression);
+		if (!m_dialect.builtin(functionCall.functionName.name))
+			return Effect::Observes;
+		for (Expression const& argument: functionCall.arguments)
+			if (effectOn(_store, argument) != Effect::None)
+				return Effect::Observes;
+	}
+	return Effect::None;
+}
+
+DeadStoreEliminator::Effect DeadStoreEliminator::effectOn(
+	Store const& _store,
+	FunctionalInstruction const& _instruction,
+	bool _topLevel
+) const
+{
+	// Arguments are evaluated before the instruction and cannot end execution.
+	for (Expression const& argument: _instruction.arguments)
+		if (effectOn(_store, argument) != Effect::None)
+			return Effect::Observes;
+
+	auto const& arguments = _instruction.arguments;
+	auto readsRange = [&](size_t _offset, size_t _length)
+	{
+		return disjoint(_store, arguments.at(_offset), arguments.at(_length)) ? Effect::None : Effect::Observes;
+	};
+
+	if (_store.storage)
+		switch (_instruction.instruction)
+		{
+		case eth::Instruction::SSTORE:
+			return (_topLevel && equal(*_store.location, arguments.at(0))) ? Effect::Overwrites : Effect::None;
+		case eth::Instruction::SLOAD:
+		{
+			boost::optional<u256> slot = constantValue(arguments.at(0));
+			boost::optional<u256> storeSlot = constantValue(*_store.location);
+			return (slot && storeSlot && *slot != *storeSlot) ? Effect::None : Effect::Observes;
+		}
+		case eth::Instruction::CALL:
+		case eth::Instruction::CALLCODE:
+		case eth::Instruction::DELEGATECALL:
+		case eth::Instruction::STATICCALL:
+		case eth::Instruction::CREATE:
+		case eth::Instruction::CREATE2:
+		case eth::Instruction::RETURN:
+		case eth::Instruction::STOP:
+		case eth::Instruction::SELFDESTRUCT:
+			return Effect::Observes;
+		case eth::Instruction::REVERT:
+		case eth::Instruction::INVALID:
+			return Effect::Discards;
+		default:
+			return Effect::None;
+		}
+
+	switch (_instruction.instruction)
+	{
+	case eth::Instruction::MSTORE:
+	case eth::Instruction::MSTORE8:
+	{
+		if (!_topLevel)
+			return Effect::None;
+		u256 length = _instruction.instruction == eth::Instruction::MSTORE ? 32 : 1;
+		if (equal(*_store.location, arguments.at(0)))
+			return length >= _store.length ? Effect::Overwrites : Effect::None;
+		boost::optional<u256> offset = constantValue(arguments.at(0));
+		boost::optional<u256> storeOffset = constantValue(*_store.location);
+		if (
+			offset && storeOffset &&
+			*offset <= *storeOffset &&
+			bigint(*storeOffset) + _store.length <= bigint(*offset) + length
+		)
+			return Effect::Overwrites;
+		return Effect::None;
+	}
+	case eth::Instruction::MLOAD:
+	{
+		Expression const wordSize{Literal{{}, LiteralKind::Number, YulString{"32"}, {}}};
+		return disjoint(_store, arguments.at(0), wordSize) ? Effect::None : Effect::Observes;
+	}
+	case eth::Instruction::KECCAK256:
+	case eth::Instruction::LOG0:
+	case eth::Instruction::LOG1:
+	case eth::Instruction::LOG2:
+	case eth::Instruction::LOG3:
+	case eth::Instruction::LOG4:
+		return readsRange(0, 1);
+	case eth::Instruction::CREATE:
+	case eth::Instruction::CREATE2:
+		return readsRange(1, 2);
+	case eth::Instruction::CALL:
+	case eth::Instruction::CALLCODE:
+		return readsRange(3, 4);
+	case eth::Instruction::DELEGATECALL:
+	case eth::Instruction::STATICCALL:
+		return readsRange(2, 3);
+	case eth::Instruction::RETURN:
+	case eth::Instruction::REVERT:
+		return readsRange(0, 1) == Effect::None ? Effect::Discards : Effect::Observes;
+	case eth::Instruction::STOP:
+	case eth::Instruction::INVALID:
+	case eth::Instruction::SELFDESTRUCT:
+		return Effect::Discards;
+	case eth::Instruction::MSIZE:
+		return Effect::Observes;
+	default:
+		return Effect::None;
+	}
+}
+
+bool DeadStoreEliminator::disjoint(Store const& _store, Expression const& _offset, Expression const& _length) const
+{
+	boost::optional<u256> length = constantValue(_length);
+	if (length && *length == 0)
+		return true;
+	boost::optional<u256> offset = constantValue(_offset);
+	boost::optional<u256> storeOffset = constantValue(*_store.location);
+	if (!length || !offset || !storeOffset)
+		return false;
+	return
+		bigint(*offset) + *length <= *storeOffset ||
+		bigint(*storeOffset) + _store.length <= *offset;
+}
+
+bool DeadStoreEliminator::equal(Expression const& _a, Expression const& _b) const
+{
+	if (
+		_a.type() == typeid(Identifier) &&
+		_b.type() == typeid(Identifier) &&
+		boost::get<Identifier>(_a).name == boost::get<Identifier>(_b).name &&
+		m_ssaValues.count(boost::get<Identifier>(_a).name)
+	)
+		return true;
+	boost::optional<u256> a = constantValue(_a);
+	boost::optional<u256> b = constantValue(_b);
+	return a && b && *a == *b;
+}
+
+boost::optional<u256> DeadStoreEliminator::constantValue(Expression const& _expression) const
+{
+	if (_expression.type() == typeid(Literal))
+		return valueOfLiteral(boost::get<Literal>(_expression));
+	else if (_expression.type() == typeid(Identifier))
+	{
+		auto it = m_ssaValues.find(boost::get<Identifier>(_expression).name);
+		if (it != m_ssaValues.end() && it->second)
+			return constantValue(*it->second);
+	}
+	return {};
+}
@@ -0,0 +1,112 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimiser component that removes stores to memory and storage whose effect is never observed.
+ */
+
+#pragma once
+
+#include <libyul/AsmDataForward.h>
+#include <libyul/YulString.h>
+#include <libyul/optimiser/ASTWalker.h>
+
+#include <libdevcore/Common.h>
+
+#include <boost/optional.hpp>
+
+#include <map>
+
+namespace yul
+{
+struct Dialect;
+
+/**
+ * Removes ``mstore``, ``mstore8`` and ``sstore`` statements whose effect is never observed
+ * because, following the statements of the same block, the location is overwritten
+ * before it is read, or execution ends without the location being read.
+ *
+ * A store to storage is removed if the same slot is written again or execution reverts
+ * before storage is read or an external call is performed. A store to memory is removed
+ * if a later store fully covers its range, or execution ends by ``revert`` or ``return``
+ * of a disjoint range (or ``stop`` or ``invalid``) before the range is read.
+ *
+ * Locations are compared using constant values of literals and SSA variables, or by
+ * referring to the same SSA variable. Statements other than expression statements,
+ * variable declarations and assignments as well as calls to user-defined functions
+ * end the search. If ``msize`` is used anywhere in the code, stores to memory are kept.
+ *
+ * Example:
+ *
+ * let x := calldataload(0)
+ * sstore(x, 1)
+ * mstore(0x20, 2)
+ * sstore(x, 3)
+ * return(0, 0x20)
+ *
+ * is transformed to
+ *
+ * let x := calldataload(0)
+ * sstore(x, 3)
+ * return(0, 0x20)
+ *
+ * The component works best on code in SSA form with split expressions.
+ *
+ * Prerequisite: Disambiguator.
+ */
+class DeadStoreEliminator: public ASTModifier
+{
+public:
+	static void run(Dialect const& _dialect, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(Block& _block) override;
+
+private:
+	/// A store to memory or storage at @a location (with @a length bytes if it is a memory store).
+	struct Store
+	{
+		bool storage;
+		Expression const* location;
+		dev::u256 length;
+	};
+	/// The effect a statement or expression has on the content written by a store.
+	enum class Effect { None, Observes, Overwrites, Discards };
+
+	DeadStoreEliminator(
+		Dialect const& _dialect,
+		std::map<YulString, Expression const*> _ssaValues,
+		bool _usesMSize
+	);
+
+	/// @returns the store performed by @a _statement if it is a removable store statement.
+	boost::optional<Store> storeIn(Statement const& _statement) const;
+	Effect effectOn(Store const& _store, Statement const& _statement) const;
+	Effect effectOn(Store const& _store, Expression const& _expression, bool _topLevel = false) const;
+	Effect effectOn(Store const& _store, FunctionalInstruction const& _instruction, bool _topLevel) const;
+	/// @returns true if the memory range given by @a _offset and @a _length is disjoint
+	/// from the range written by @a _store.
+	bool disjoint(Store const& _store, Expression const& _offset, Expression const& _length) const;
+	/// @returns true if both expressions are known to have the same value.
+	bool equal(Expression const& _a, Expression const& _b) const;
+	boost::optional<dev::u256> constantValue(Expression const& _expression) const;
+
+	Dialect const& m_dialect;
+	std::map<YulString, Expression const*> const m_ssaValues;
+	bool const m_usesMSize;
+};
+
+}
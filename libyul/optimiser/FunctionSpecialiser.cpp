@@ -0,0 +1,226 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimiser component that specialises functions for constant arguments.
+ */
+
+#include <libyul/optimiser/FunctionSpecialiser.h>
+
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/BlockFlattener.h>
+#include <libyul/optimiser/ExpressionSimplifier.h>
+#include <libyul/optimiser/FullInliner.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/Rematerialiser.h>
+#include <libyul/optimiser/StructuralSimplifier.h>
+#include <libyul/optimiser/UnusedPruner.h>
+#include <libyul/AsmData.h>
+#include <libyul/Dialect.h>
+#include <libyul/Utilities.h>
+
+#include <libdevcore/CommonData.h>
+
+using namespace std;
+using namespace dev;
+using namespace yul;
+
+namespace
+{
+
+/// Very rough gas costs of one unit of code size when executing and when deploying the code.
+size_t const runtimeGasPerSize = 3;
+size_t const deploymentGasPerSize = 200;
+
+/// Counts the calls to each combination of function and constant arguments.
+class CallCounter: public ASTWalker
+{
+public:
+	explicit CallCounter(function<void(FunctionCall const&)> _callback): m_callback(std::move(_callback)) {}
+
+	using ASTWalker::operator();
+	void operator()(FunctionCall const& _funCall) override
+	{
+		ASTWalker::operator()(_funCall);
+		m_callback(_funCall);
+	}
+
+private:
+	function<void(FunctionCall const&)> m_callback;
+};
+
+}
+
+void FunctionSpecialiser::run(
+	Dialect const& _dialect,
+	Block& _ast,
+	NameDispenser& _nameDispenser,
+	size_t _expectedExecutionsPerDeployment
+)
+{
+	// Literals in typed Yul carry types that are not tracked here.
+	if (_dialect.flavour == AsmFlavour::Yul)
+		return;
+	FunctionSpecialiser{_dialect, _ast, _nameDispenser, _expectedExecutionsPerDeployment}.run();
+}
+
+FunctionSpecialiser::FunctionSpecialiser(
+	Dialect const& _dialect,
+	Block& _ast,
+	NameDispenser& _nameDispenser,
+	size_t _expectedExecutionsPerDeployment
+):
+	m_dialect(_dialect),
+	m_ast(_ast),
+	m_nameDispenser(_nameDispenser),
+	m_expectedExecutionsPerDeployment(_expectedExecutionsPerDeployment)
+{
+	for (auto const& statement: _ast.statements)
+		if (statement.type() == typeid(FunctionDefinition))
+		{
+			auto const& function = boost::get<FunctionDefinition>(statement);
+			m_functions[function.name] = &function;
+		}
+	m_ssaValues(_ast);
+}
+
+void FunctionSpecialiser::run()
+{
+	map<YulString, size_t> calls;
+	map<Specialisation, size_t> specialisedCalls;
+	CallCounter{[&](FunctionCall const& _funCall) {
+		YulString name = _funCall.functionName.name;
+		if (!m_functions.count(name))
+			return;
+		++calls[name];
+		ConstantArguments arguments = constantArguments(_funCall);
+		if (any_of(arguments.begin(), arguments.end(), [](boost::optional<u256> const& _v) { return !!_v; }))
+			++specialisedCalls[make_pair(name, arguments)];
+	}}(m_ast);
+
+	vector<Statement> specialisedFunctions;
+	for (auto const& specialisation: specialisedCalls)
+	{
+		FunctionDefinition const& original = *m_functions.at(specialisation.first.first);
+		FunctionDefinition copy = boost::get<FunctionDefinition>(ASTCopier{}(original));
+		size_t originalSize = simplifiedSize(copy);
+		FunctionDefinition specialised = specialise(original, specialisation.first.second);
+		size_t specialisedSize = simplifiedSize(specialised);
+		if (specialisedSize >= originalSize)
+			continue;
+
+		size_t addedSize = specialisation.second == calls.at(original.name) ? 0 : specialisedSize;
+		bigint savings =
+			bigint(originalSize - specialisedSize) * runtimeGasPerSize *
+			specialisation.second * m_expectedExecutionsPerDeployment;
+		if (savings < bigint(addedSize) * deploymentGasPerSize)
+			continue;
+
+		m_specialisations[specialisation.first] = specialised.name;
+		specialisedFunctions.emplace_back(std::move(specialised));
+	}
+
+	(*this)(m_ast);
+	m_ast.statements += std::move(specialisedFunctions);
+}
+
+void FunctionSpecialiser::operator()(FunctionCall& _funCall)
+{
+	ASTModifier::operator()(_funCall);
+	if (!m_functions.count(_funCall.functionName.name))
+		return;
+	ConstantArguments arguments = constantArguments(_funCall);
+	auto it = m_specialisations.find(make_pair(_funCall.functionName.name, arguments));
+	if (it == m_specialisations.end())
+		return;
+
+	_funCall.functionName.name = it->second;
+	vector<Expression> remainingArguments;
+	for (size_t i = 0; i < arguments.size(); ++i)
+		if (!arguments[i])
+			remainingArguments.emplace_back(std::move(_funCall.arguments[i]));
+	_funCall.arguments = std::move(remainingArguments);
+}
+
+FunctionDefinition FunctionSpecialiser::specialise(
+	FunctionDefinition const& _function,
+	ConstantArguments const& _arguments
+)
+{
+	FunctionDefinition specialised{_function.location, m_nameDispenser.newName(_function.name), {}, {}, {}};
+	map<YulString, YulString> replacements;
+	vector<Statement> constants;
+	for (size_t i = 0; i < _function.parameters.size(); ++i)
+	{
+		TypedName const& parameter = _function.parameters[i];
+		YulString name = m_nameDispenser.newName(parameter.name);
+		replacements[parameter.name] = name;
+		if (_arguments[i])
+			constants.emplace_back(VariableDeclaration{
+				parameter.location,
+				{TypedName{parameter.location, name, parameter.type}},
+				make_unique<Expression>(Literal{
+					parameter.location,
+					LiteralKind::Number,
+					YulString{formatNumber(*_arguments[i])},
+					parameter.type
+				})
+			});
+		else
+			specialised.parameters.emplace_back(TypedName{parameter.location, name, parameter.type});
+	}
+	for (TypedName const& returnVariable: _function.returnVariables)
+	{
+		YulString name = m_nameDispenser.newName(returnVariable.name);
+		replacements[returnVariable.name] = name;
+		specialised.returnVariables.emplace_back(TypedName{returnVariable.location, name, returnVariable.type});
+	}
+	specialised.body = boost::get<Block>(BodyCopier{m_nameDispenser, replacements}(_function.body));
+	specialised.body.statements = std::move(constants) + std::move(specialised.body.statements);
+	return specialised;
+}
+
+size_t FunctionSpecialiser::simplifiedSize(FunctionDefinition& _function) const
+{
+	ExpressionSimplifier::run(m_dialect, _function.body);
+	StructuralSimplifier{m_dialect}(_function.body);
+	BlockFlattener{}(_function.body);
+	Rematerialiser::run(m_dialect, _function);
+	UnusedPruner::runUntilStabilised(m_dialect, _function);
+	return CodeSize::codeSize(_function.body);
+}
+
+FunctionSpecialiser::ConstantArguments FunctionSpecialiser::constantArguments(FunctionCall const& _funCall) const
+{
+	ConstantArguments arguments;
+	for (Expression const& argument: _funCall.arguments)
+		arguments.emplace_back(constantValue(argument));
+	return arguments;
+}
+
+boost::optional<u256> FunctionSpecialiser::constantValue(Expression const& _expression) const
+{
+	if (_expression.type() == typeid(Literal))
+		return valueOfLiteral(boost::get<Literal>(_expression));
+	else if (_expression.type() == typeid(Identifier))
+	{
+		auto it = m_ssaValues.values().find(boost::get<Identifier>(_expression).name);
+		if (it != m_ssaValues.values().end() && it->second)
+			return constantValue(*it->second);
+	}
+	return {};
+}
@@ -0,0 +1,112 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimiser component that specialises functions for constant arguments.
+ */
+
+#pragma once
+
+#include <libyul/AsmDataForward.h>
+#include <libyul/YulString.h>
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/SSAValueTracker.h>
+
+#include <libdevcore/Common.h>
+
+#include <boost/optional.hpp>
+
+#include <map>
+#include <vector>
+
+namespace yul
+{
+struct Dialect;
+class NameDispenser;
+
+/**
+ * Creates copies of functions that are called with constant arguments, where the
+ * constant parameters are replaced by variables initialised to the constants, and
+ * redirects the calls to these copies.
+ *
+ * A copy is created for each distinct combination of constant arguments. Literals and
+ * SSA variables with literal values count as constants. The copy is simplified using the
+ * Expression Simplifier and the Structural Simplifier and only kept if it is smaller than
+ * the original function simplified in the same way. The added code has to be paid for
+ * by the runtime savings of all calls that use the copy, given the expected number of
+ * executions per deployment. No copy is counted as added code if all calls to the
+ * function use it, since the original is removed by the Unused Pruner later on.
+ *
+ * Example:
+ *
+ * function f(a, b) -> r { switch a case 0 { r := b } default { r := mul(a, b) } }
+ * let x := f(0, calldataload(0))
+ *
+ * is transformed to
+ *
+ * function f(a, b) -> r { switch a case 0 { r := b } default { r := mul(a, b) } }
+ * function f_1(b_3) -> r_4 { r_4 := b_3 }
+ * let x := f_1(calldataload(0))
+ *
+ * Copies that end up identical are merged by the Equivalent Function Combiner.
+ *
+ * Prerequisite: Disambiguator, Function Hoister.
+ */
+class FunctionSpecialiser: public ASTModifier
+{
+public:
+	static void run(
+		Dialect const& _dialect,
+		Block& _ast,
+		NameDispenser& _nameDispenser,
+		size_t _expectedExecutionsPerDeployment
+	);
+
+	using ASTModifier::operator();
+	void operator()(FunctionCall& _funCall) override;
+
+private:
+	/// The constant value of each argument of a call, if known.
+	using ConstantArguments = std::vector<boost::optional<dev::u256>>;
+	using Specialisation = std::pair<YulString, ConstantArguments>;
+
+	FunctionSpecialiser(
+		Dialect const& _dialect,
+		Block& _ast,
+		NameDispenser& _nameDispenser,
+		size_t _expectedExecutionsPerDeployment
+	);
+
+	void run();
+	/// @returns a copy of @a _function with the parameters for which @a _arguments contains
+	/// a value replaced by variables initialised to these values.
+	FunctionDefinition specialise(FunctionDefinition const& _function, ConstantArguments const& _arguments);
+	/// Runs the simplification steps on @a _function and @returns its resulting size.
+	size_t simplifiedSize(FunctionDefinition& _function) const;
+	ConstantArguments constantArguments(FunctionCall const& _funCall) const;
+	boost::optional<dev::u256> constantValue(Expression const& _expression) const;
+
+	Dialect const& m_dialect;
+	Block& m_ast;
+	NameDispenser& m_nameDispenser;
+	size_t const m_expectedExecutionsPerDeployment;
+	std::map<YulString, FunctionDefinition const*> m_functions;
+	SSAValueTracker m_ssaValues;
+	/// Names of the specialised copies.
+	std::map<Specialisation, YulString> m_specialisations;
+};
+
+}
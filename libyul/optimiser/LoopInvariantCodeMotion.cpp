@@ -0,0 +1,159 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimiser component that moves loop-invariant variable declarations out of for loops.
+ */
+
+#include <libyul/optimiser/LoopInvariantCodeMotion.h>
+
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SSAValueTracker.h>
+#include <libyul/AsmData.h>
+
+#include <libdevcore/CommonData.h>
+
+#include <functional>
+
+using namespace std;
+using namespace dev;
+using namespace yul;
+
+void LoopInvariantCodeMotion::run(Dialect const& _dialect, Block& _ast)
+{
+	SSAValueTracker ssaValues;
+	ssaValues(_ast);
+	set<YulString> ssaVariables;
+	for (auto const& value: ssaValues.values())
+		ssaVariables.insert(value.first);
+	LoopInvariantCodeMotion{_dialect, std::move(ssaVariables)}(_ast);
+}
+
+void LoopInvariantCodeMotion::operator()(Block& _block)
+{
+	iterateReplacing(
+		_block.statements,
+		[&](Statement& _statement) -> boost::optional<vector<Statement>>
+		{
+			visit(_statement);
+			if (_statement.type() == typeid(ForLoop))
+				return rewriteLoop(boost::get<ForLoop>(_statement));
+			return {};
+		}
+	);
+}
+
+boost::optional<vector<Statement>> LoopInvariantCodeMotion::rewriteLoop(ForLoop& _for)
+{
+	// Declarations in the pre block are visible in the whole loop.
+	if (!_for.pre.statements.empty())
+		return {};
+
+	StorageAccessChecker loopAccess{m_dialect};
+	loopAccess.visit(*_for.condition);
+	loopAccess(_for.post);
+	loopAccess(_for.body);
+
+	vector<Statement> replacement;
+	for (Block* block: {&_for.post, &_for.body})
+	{
+		set<YulString> invariant = invariantDeclarations(*block, loopAccess.invalidatesStorage());
+		if (invariant.empty())
+			continue;
+		iterateReplacing(
+			block->statements,
+			[&](Statement& _statement) -> boost::optional<vector<Statement>>
+			{
+				if (
+					_statement.type() == typeid(VariableDeclaration) &&
+					invariant.count(boost::get<VariableDeclaration>(_statement).variables.front().name)
+				)
+				{
+					replacement.emplace_back(std::move(_statement));
+					return vector<Statement>{};
+				}
+				return {};
+			}
+		);
+	}
+	if (replacement.empty())
+		return {};
+	replacement.emplace_back(std::move(_for));
+	return replacement;
+}
+
+set<YulString> LoopInvariantCodeMotion::invariantDeclarations(Block const& _block, bool _loopModifiesStorage) const
+{
+	set<YulString> invariant;
+	set<YulString> varsDefinedInScope;
+	// Declarations of literals and copies of variables, together with the variables they reference.
+	// These are only moved if an invariant declaration references them, since moving them
+	// on their own saves nothing but increases stack pressure.
+	map<YulString, set<YulString>> cheapDeclarations;
+	function<void(YulString)> moveCheapDeclaration = [&](YulString _name)
+	{
+		if (!cheapDeclarations.count(_name) || !invariant.insert(_name).second)
+			return;
+		for (YulString const& reference: cheapDeclarations.at(_name))
+			moveCheapDeclaration(reference);
+	};
+
+	for (Statement const& statement: _block.statements)
+	{
+		if (statement.type() != typeid(VariableDeclaration))
+			continue;
+		auto const& varDecl = boost::get<VariableDeclaration>(statement);
+		if (!canBeMoved(varDecl, varsDefinedInScope, _loopModifiesStorage))
+		{
+			for (auto const& var: varDecl.variables)
+				varsDefinedInScope.insert(var.name);
+			continue;
+		}
+		set<YulString> references = StorageAccessChecker{m_dialect, *varDecl.value}.referencedVariables();
+		if (varDecl.value->type() == typeid(Literal) || varDecl.value->type() == typeid(Identifier))
+			for (auto const& var: varDecl.variables)
+				cheapDeclarations[var.name] = references;
+		else
+		{
+			for (auto const& var: varDecl.variables)
+				invariant.insert(var.name);
+			for (YulString const& reference: references)
+				moveCheapDeclaration(reference);
+		}
+	}
+	return invariant;
+}
+
+bool LoopInvariantCodeMotion::canBeMoved(
+	VariableDeclaration const& _varDecl,
+	set<YulString> const& _varsDefinedInScope,
+	bool _loopModifiesStorage
+) const
+{
+	if (!_varDecl.value)
+		return false;
+	for (auto const& var: _varDecl.variables)
+		if (!m_ssaVariables.count(var.name))
+			return false;
+
+	StorageAccessChecker checker{m_dialect, *_varDecl.value};
+	for (YulString const& name: checker.referencedVariables())
+		if (_varsDefinedInScope.count(name) || !m_ssaVariables.count(name))
+			return false;
+	return
+		checker.movableApartFromStorageReads() &&
+		(!checker.readsStorage() || !_loopModifiesStorage);
+}
@@ -0,0 +1,99 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimiser component that moves loop-invariant variable declarations out of for loops.
+ */
+
+#pragma once
+
+#include <libyul/AsmDataForward.h>
+#include <libyul/YulString.h>
+#include <libyul/optimiser/ASTWalker.h>
+
+#include <boost/optional.hpp>
+
+#include <set>
+#include <vector>
+
+namespace yul
+{
+struct Dialect;
+
+/**
+ * Moves variable declarations out of the body and the post block of for loops
+ * if their value is the same in every iteration.
+ *
+ * A declaration is moved in front of the loop if all its variables are never
+ * re-assigned and its value is movable and only references such variables
+ * declared outside of the loop (or moved before). Values that read storage
+ * are also moved if the loop does not modify storage, i.e. does not contain
+ * sstore, calls, creates or calls to user-defined functions.
+ *
+ * Example:
+ *
+ * for {} lt(i, n) { i := add(i, 1) } {
+ *   let x := add(base, 0x20)
+ *   let y := sload(x)
+ *   mstore(add(x, i), y)
+ * }
+ *
+ * is transformed to
+ *
+ * let x := add(base, 0x20)
+ * let y := sload(x)
+ * for {} lt(i, n) { i := add(i, 1) } {
+ *   mstore(add(x, i), y)
+ * }
+ *
+ * Declarations of literals and copies of variables are only moved together with
+ * declarations that reference them, since moving them on their own saves nothing
+ * but increases stack pressure.
+ * Only the top-level statements of the body and the post block are considered.
+ * The component works best on code in SSA form with split expressions.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter.
+ */
+class LoopInvariantCodeMotion: public ASTModifier
+{
+public:
+	static void run(Dialect const& _dialect, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(Block& _block) override;
+
+private:
+	LoopInvariantCodeMotion(Dialect const& _dialect, std::set<YulString> _ssaVariables):
+		m_dialect(_dialect),
+		m_ssaVariables(std::move(_ssaVariables))
+	{}
+
+	/// @returns the statements replacing @a _for if declarations could be moved out of it.
+	boost::optional<std::vector<Statement>> rewriteLoop(ForLoop& _for);
+	/// @returns the variables whose declarations at the top level of @a _block can be
+	/// moved in front of the loop.
+	std::set<YulString> invariantDeclarations(Block const& _block, bool _loopModifiesStorage) const;
+	bool canBeMoved(
+		VariableDeclaration const& _varDecl,
+		std::set<YulString> const& _varsDefinedInScope,
+		bool _loopModifiesStorage
+	) const;
+
+	Dialect const& m_dialect;
+	std::set<YulString> const m_ssaVariables;
+};
+
+}
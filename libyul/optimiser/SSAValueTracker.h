@@ -22,6 +22,7 @@
 #pragma once
 
 #include <libyul/optimiser/ASTWalker.h>
+#include <libyul/AsmData.h>
 
 #include <map>
 #include <set>
@@ -52,6 +53,9 @@ private:
 	void setValue(YulString _name, Expression const* _value);
 
 	std::map<YulString, Expression const*> m_values;
+	/// Default value of variables, a member so that it does not outlive the string repository.
+	/// Consequently, the values are only valid as long as the tracker is alive.
+	Expression const m_zero{Literal{{}, LiteralKind::Number, YulString{"0"}, {}}};
 };
 
 }
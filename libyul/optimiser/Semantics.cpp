@@ -72,3 +72,36 @@ void MovableChecker::visit(Statement const&)
 {
 	assertThrow(false, OptimizerException, "Movability for statement requested.");
 }
+
+StorageAccessChecker::StorageAccessChecker(Dialect const& _dialect, Expression const& _expression):
+	StorageAccessChecker(_dialect)
+{
+	visit(_expression);
+}
+
+void StorageAccessChecker::operator()(Identifier const& _identifier)
+{
+	ASTWalker::operator()(_identifier);
+	m_variableReferences.emplace(_identifier.name);
+}
+
+void StorageAccessChecker::operator()(FunctionalInstruction const& _instr)
+{
+	if (_instr.instruction == eth::Instruction::SLOAD)
+		m_readsStorage = true;
+	else if (!eth::SemanticInformation::movable(_instr.instruction))
+		m_movable = false;
+	if (eth::SemanticInformation::invalidatesStorage(_instr.instruction))
+		m_invalidatesStorage = true;
+	ASTWalker::operator()(_instr);
+}
+
+void StorageAccessChecker::operator()(FunctionCall const& _functionCall)
+{
+	BuiltinFunction const* f = m_dialect.builtin(_functionCall.functionName.name);
+	if (!f || !f->movable)
+		m_movable = false;
+	if (!f)
+		m_invalidatesStorage = true;
+	ASTWalker::operator()(_functionCall);
+}
@@ -56,4 +56,34 @@ private:
 	bool m_movable = true;
 };
 
+/**
+ * Specific AST walker that determines whether the visited code reads or modifies storage.
+ * Calls to non-builtin functions are assumed to modify storage.
+ */
+class StorageAccessChecker: public ASTWalker
+{
+public:
+	explicit StorageAccessChecker(Dialect const& _dialect): m_dialect(_dialect) {}
+	StorageAccessChecker(Dialect const& _dialect, Expression const& _expression);
+
+	using ASTWalker::operator();
+	void operator()(Identifier const& _identifier) override;
+	void operator()(FunctionalInstruction const& _functionalInstruction) override;
+	void operator()(FunctionCall const& _functionCall) override;
+
+	/// @returns true if the visited code is movable apart from reading storage, i.e. it
+	/// can be moved as long as storage is not modified in between.
+	bool movableApartFromStorageReads() const { return m_movable; }
+	bool readsStorage() const { return m_readsStorage; }
+	bool invalidatesStorage() const { return m_invalidatesStorage; }
+	std::set<YulString> const& referencedVariables() const { return m_variableReferences; }
+
+private:
+	Dialect const& m_dialect;
+	std::set<YulString> m_variableReferences;
+	bool m_movable = true;
+	bool m_readsStorage = false;
+	bool m_invalidatesStorage = false;
+};
+
 }
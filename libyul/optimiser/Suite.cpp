@@ -21,6 +21,7 @@
 #include <libyul/optimiser/Suite.h>
 
 #include <libyul/optimiser/Disambiguator.h>
+#include <libyul/optimiser/DeadStoreEliminator.h>
 #include <libyul/optimiser/VarDeclInitializer.h>
 #include <libyul/optimiser/BlockFlattener.h>
 #include <libyul/optimiser/FunctionGrouper.h>
@@ -31,6 +32,8 @@
 #include <libyul/optimiser/ExpressionInliner.h>
 #include <libyul/optimiser/FullInliner.h>
 #include <libyul/optimiser/ForLoopInitRewriter.h>
+#include <libyul/optimiser/FunctionSpecialiser.h>
+#include <libyul/optimiser/LoopInvariantCodeMotion.h>
 #include <libyul/optimiser/Rematerialiser.h>
 #include <libyul/optimiser/UnusedPruner.h>
 #include <libyul/optimiser/ExpressionSimplifier.h>
@@ -60,7 +63,8 @@ void OptimiserSuite::run(
 	Block& _ast,
 	AsmAnalysisInfo const& _analysisInfo,
 	bool _optimizeStackAllocation,
-	set<YulString> const& _externallyUsedIdentifiers
+	set<YulString> const& _externallyUsedIdentifiers,
+	size_t _expectedExecutionsPerDeployment
 )
 {
 	set<YulString> reservedIdentifiers = _externallyUsedIdentifiers;
@@ -101,6 +105,8 @@ void OptimiserSuite::run(
 
 			ExpressionSimplifier::run(*_dialect, ast);
 			CommonSubexpressionEliminator{*_dialect}(ast);
+			LoopInvariantCodeMotion::run(*_dialect, ast);
+			DeadStoreEliminator::run(*_dialect, ast);
 		}
 
 		{
@@ -145,6 +151,7 @@ void OptimiserSuite::run(
 		{
 			// run full inliner
 			FunctionGrouper{}(ast);
+			FunctionSpecialiser::run(*_dialect, ast, dispenser, _expectedExecutionsPerDeployment);
 			EquivalentFunctionCombiner::run(ast);
 			FullInliner{ast, dispenser}.run();
 			BlockFlattener{}(ast);
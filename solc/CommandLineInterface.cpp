@@ -471,13 +471,13 @@ bool CommandLineInterface::readInputFilesAndConfigureRemappings()
 					continue;
 				}
 
-				m_sourceCodes[infile.generic_string()] = dev::readFileAsString(infile.string());
+				m_sourceCodes[infile.generic_string()] = make_shared<string const>(dev::readFileAsString(infile.string()));
 				path = boost::filesystem::canonical(infile).string();
 			}
 			m_allowedDirectories.push_back(boost::filesystem::path(path).remove_filename());
 		}
 	if (addStdin)
-		m_sourceCodes[g_stdinFileName] = dev::readStandardInput();
+		m_sourceCodes[g_stdinFileName] = make_shared<string const>(dev::readStandardInput());
 	if (m_sourceCodes.size() == 0)
 	{
 		serr() << "No input files given. If you wish to use the standard input please specify \"-\" explicitly." << endl;
@@ -783,9 +783,9 @@ bool CommandLineInterface::processInput()
 			if (!boost::filesystem::is_regular_file(canonicalPath))
 				return ReadCallback::Result{false, "Not a valid file."};
 
-			auto contents = dev::readFileAsString(canonicalPath.string());
+			auto contents = make_shared<string const>(dev::readFileAsString(canonicalPath.string()));
 			m_sourceCodes[path.generic_string()] = contents;
-			return ReadCallback::Result{true, contents};
+			return ReadCallback::Result{true, *contents};
 		}
 		catch (Exception const& _exception)
 		{
@@ -1095,7 +1095,7 @@ void CommandLineInterface::handleAst(string const& _argStr)
 				string postfix = "";
 				if (_argStr == g_argAst)
 				{
-					ASTPrinter printer(m_compiler->ast(sourceCode.first), sourceCode.second);
+					ASTPrinter printer(m_compiler->ast(sourceCode.first), *sourceCode.second);
 					printer.print(data);
 				}
 				else
@@ -1117,7 +1117,7 @@ void CommandLineInterface::handleAst(string const& _argStr)
 				{
 					ASTPrinter printer(
 						m_compiler->ast(sourceCode.first),
-						sourceCode.second,
+						*sourceCode.second,
 						gasCosts
 					);
 					printer.print(sout());
@@ -1143,53 +1143,35 @@ bool CommandLineInterface::actOnInput()
 
 bool CommandLineInterface::link()
 {
-	// Map from how the libraries will be named inside the bytecode to their addresses.
-	map<string, h160> librariesReplacements;
-	int const placeholderSize = 40; // 20 bytes or 40 hex characters
-	for (auto const& library: m_libraries)
-	{
-		string const& name = library.first;
-		// Library placeholders are 40 hex digits (20 bytes) that start and end with '__'.
-		// This leaves 36 characters for the library identifier. The identifier used to
-		// be just the cropped or '_'-padded library name, but this changed to
-		// the cropped hex representation of the hash of the library name.
-		// We support both ways of linking here.
-		librariesReplacements["__" + eth::LinkerObject::libraryPlaceholder(name) + "__"] = library.second;
-
-		string replacement = "__";
-		for (size_t i = 0; i < placeholderSize - 4; ++i)
-			replacement.push_back(i < name.size() ? name[i] : '_');
-		replacement += "__";
-		librariesReplacements[replacement] = library.second;
-	}
+	// Index the libraries once by the placeholders they can have in the bytecode.
+	eth::LinkerObject::Libraries libraries(m_libraries);
+	vector<string> unresolved;
 	for (auto& src: m_sourceCodes)
 	{
-		auto end = src.second.end();
-		for (auto it = src.second.begin(); it != end;)
+		string code = *src.second;
+		unresolved.clear();
+		bool complete = eth::LinkerObject::linkHex(code, libraries, unresolved);
+		for (string const& name: unresolved)
+			serr() << "Reference \"" << name << "\" in file \"" << src.first << "\" still unresolved." << endl;
+		if (!complete)
 		{
-			while (it != end && *it != '_') ++it;
-			if (it == end) break;
-			if (end - it < placeholderSize)
-			{
-				serr() << "Error in binary object file " << src.first << " at position " << (end - src.second.begin()) << endl;
-				return false;
-			}
-
-			string name(it, it + placeholderSize);
-			if (librariesReplacements.count(name))
-			{
-				string hexStr(toHex(librariesReplacements.at(name).asBytes()));
-				copy(hexStr.begin(), hexStr.end(), it);
-			}
-			else
-				serr() << "Reference \"" << name << "\" in file \"" << src.first << "\" still unresolved." << endl;
-			it += placeholderSize;
+			serr() << "Error in binary object file " << src.first << " at position " << code.size() << endl;
+			return false;
+		}
+		// Remove hints for resolved libraries. They all start with a newline and thus
+		// can only appear after the bytecode.
+		size_t hintsStart = code.find('\n');
+		if (hintsStart != string::npos)
+		{
+			string hints = code.substr(hintsStart);
+			for (auto const& library: m_libraries)
+				boost::algorithm::erase_all(hints, "\n" + libraryPlaceholderHint(library.first));
+			code.resize(hintsStart);
+			code += hints;
 		}
-		// Remove hints for resolved libraries.
-		for (auto const& library: m_libraries)
-			boost::algorithm::erase_all(src.second, "\n" + libraryPlaceholderHint(library.first));
-		while (!src.second.empty() && *prev(src.second.end()) == '\n')
-			src.second.resize(src.second.size() - 1);
+		while (!code.empty() && *prev(code.end()) == '\n')
+			code.resize(code.size() - 1);
+		src.second = make_shared<string const>(std::move(code));
 	}
 	return true;
 }
@@ -1198,11 +1180,11 @@ void CommandLineInterface::writeLinkedFiles()
 {
 	for (auto const& src: m_sourceCodes)
 		if (src.first == g_stdinFileName)
-			sout() << src.second << endl;
+			sout() << *src.second << endl;
 		else
 		{
 			ofstream outFile(src.first);
-			outFile << src.second;
+			outFile << *src.second;
 			if (!outFile)
 			{
 				serr() << "Could not write to file " << src.first << ". Aborting." << endl;
@@ -1246,7 +1228,7 @@ bool CommandLineInterface::assemble(
 		);
 		try
 		{
-			if (!stack.parseAndAnalyze(src.first, src.second))
+			if (!stack.parseAndAnalyze(src.first, *src.second))
 				successful = false;
 			else
 				stack.optimize();
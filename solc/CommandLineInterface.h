@@ -97,8 +97,8 @@ private:
 
 	/// Compiler arguments variable map
 	boost::program_options::variables_map m_args;
-	/// map of input files to source code strings
-	std::map<std::string, std::string> m_sourceCodes;
+	/// map of input files to source code strings, shared with the compiler stack
+	SharedStringMap m_sourceCodes;
 	/// list of remappings
 	std::vector<dev::solidity::CompilerStack::Remapping> m_remappings;
 	/// list of allowed directories to read files from
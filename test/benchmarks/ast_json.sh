@@ -0,0 +1,62 @@
+#!/usr/bin/env bash
+
+#------------------------------------------------------------------------------
+# Compares time and peak memory of the streaming AST JSON output
+# (--ast-compact-json) with the tree based one (--combined-json ast).
+#
+# Usage: ast_json.sh <path to solc> [number of copies of the corpus]
+#
+# The input project is built from several copies of test/compilationTests
+# placed below distinct directories, so that it consists of many large sources.
+# ------------------------------------------------------------------------------
+# This file is part of solidity.
+#
+# solidity is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# solidity is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with solidity.  If not, see <http://www.gnu.org/licenses/>
+#
+# (c) 2019 solidity contributors.
+#------------------------------------------------------------------------------
+
+set -e
+
+if [ ! -x "$1" ]
+then
+    echo "Usage: $0 <path to solc> [copies]"
+    exit 1
+fi
+
+SOLC=$(cd "$(dirname "$1")" && pwd)/$(basename "$1")
+COPIES=${2:-20}
+REPO_ROOT=$(cd "$(dirname "$0")/../.." && pwd)
+TMPDIR=$(mktemp -d)
+trap 'rm -rf "$TMPDIR"' EXIT
+
+for i in $(seq 1 "$COPIES")
+do
+    mkdir -p "$TMPDIR/copy$i"
+    cp -r "$REPO_ROOT"/test/compilationTests/* "$TMPDIR/copy$i/"
+done
+cd "$TMPDIR"
+SOURCES=$(find . -name '*.sol' | sort)
+
+function measure()
+{
+    local title="$1"
+    shift
+    /usr/bin/time -f "$title: %e s, peak RSS %M KiB" "$SOLC" "$@" $SOURCES > output.txt
+    echo "    output size: $(wc -c < output.txt) bytes"
+}
+
+echo "$(echo "$SOURCES" | wc -l) source files"
+measure "--ast-compact-json (streaming)" --ast-compact-json
+measure "--combined-json ast,compact-format (tree)" --combined-json ast,compact-format
@@ -0,0 +1,86 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the Keccak256 hash functions.
+ */
+
+#include <libdevcore/Keccak256.h>
+
+#include <test/Options.h>
+
+using namespace std;
+
+namespace dev
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(Keccak256)
+
+BOOST_AUTO_TEST_CASE(empty)
+{
+	BOOST_CHECK_EQUAL(
+		keccak256(bytes()),
+		h256("0xc5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470")
+	);
+}
+
+BOOST_AUTO_TEST_CASE(many_matches_single)
+{
+	// Lengths around the rate of 136 bytes, in an order that mixes
+	// inputs with different numbers of blocks in the same group.
+	vector<bytes> inputs;
+	for (size_t length: {0, 1, 135, 136, 137, 271, 272, 273, 4104, 31, 32, 33, 5000})
+	{
+		bytes input(length);
+		for (size_t i = 0; i < length; ++i)
+			input[i] = uint8_t(i * 7 + length);
+		inputs.emplace_back(move(input));
+	}
+
+	for (size_t count = 0; count <= inputs.size(); ++count)
+	{
+		vector<bytesConstRef> refs;
+		for (size_t i = 0; i < count; ++i)
+			refs.emplace_back(&inputs[i]);
+		vector<h256> hashes = keccak256Many(refs);
+		BOOST_REQUIRE_EQUAL(hashes.size(), count);
+		for (size_t i = 0; i < count; ++i)
+			BOOST_CHECK_EQUAL(hashes[i], keccak256(inputs[i]));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(many_concatenated)
+{
+	bytes data(1000);
+	for (size_t i = 0; i < data.size(); ++i)
+		data[i] = uint8_t(i);
+	bytesConstRef ref(&data);
+
+	vector<pair<bytesConstRef, bytesConstRef>> inputs;
+	for (size_t split: {0, 1, 8, 135, 136, 137, 500, 999, 1000})
+		inputs.emplace_back(ref.cropped(0, split), ref.cropped(split));
+	vector<h256> hashes = keccak256Many(inputs);
+	BOOST_REQUIRE_EQUAL(hashes.size(), inputs.size());
+	for (auto const& hash: hashes)
+		BOOST_CHECK_EQUAL(hash, keccak256(data));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
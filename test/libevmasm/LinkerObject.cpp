@@ -0,0 +1,91 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Tests for linking bytecode and hex code.
+ */
+
+#include <libevmasm/LinkerObject.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace dev::eth;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+namespace
+{
+	h160 const address("90f20564390eae531e810af625a22f51385cd222");
+}
+
+BOOST_AUTO_TEST_SUITE(Linker)
+
+BOOST_AUTO_TEST_CASE(link_references)
+{
+	LinkerObject object;
+	object.bytecode = bytes(64, 0);
+	object.linkReferences[1] = "x.sol:L";
+	object.linkReferences[30] = "y.sol:M";
+	object.link({{"L", address}});
+	BOOST_CHECK_EQUAL(object.linkReferences.size(), 1);
+	BOOST_CHECK_EQUAL(object.linkReferences.count(30), 1);
+	BOOST_CHECK(h160(bytesConstRef(object.bytecode.data() + 1, 20)) == address);
+	BOOST_CHECK_EQUAL(object.bytecode[0], 0);
+	BOOST_CHECK_EQUAL(object.bytecode[21], 0);
+
+	// Fully qualified names take precedence.
+	LinkerObject::Libraries libraries({{"y.sol:M", address}, {"M", h160()}});
+	object.link(libraries);
+	BOOST_CHECK(object.linkReferences.empty());
+	BOOST_CHECK(h160(bytesConstRef(object.bytecode.data() + 30, 20)) == address);
+}
+
+BOOST_AUTO_TEST_CASE(link_hex)
+{
+	string const hashed = "__" + LinkerObject::libraryPlaceholder("x.sol:L") + "__";
+	string const legacy = "__x.sol:M" + string(29, '_') + "__";
+	string const unknown = "__" + LinkerObject::libraryPlaceholder("x.sol:N") + "__";
+	string hex = "6060" + hashed + "01" + legacy + unknown + "00";
+	LinkerObject::Libraries libraries({{"x.sol:L", address}, {"x.sol:M", address}});
+
+	vector<string> unresolved;
+	BOOST_CHECK(LinkerObject::linkHex(hex, libraries, unresolved));
+	BOOST_CHECK_EQUAL(hex, "6060" + address.hex() + "01" + address.hex() + unknown + "00");
+	BOOST_REQUIRE_EQUAL(unresolved.size(), 1);
+	BOOST_CHECK_EQUAL(unresolved.front(), unknown);
+}
+
+BOOST_AUTO_TEST_CASE(link_hex_truncated)
+{
+	string hex = "6060" + ("__" + LinkerObject::libraryPlaceholder("x.sol:L")).substr(0, 30);
+	vector<string> unresolved;
+	BOOST_CHECK(!LinkerObject::linkHex(hex, LinkerObject::Libraries({{"x.sol:L", address}}), unresolved));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+} // end namespaces
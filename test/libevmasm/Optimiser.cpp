@@ -1158,6 +1158,58 @@ BOOST_AUTO_TEST_CASE(jumpdest_removal_subassemblies)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(sibling_subassemblies)
+{
+	// This tests that sibling sub-assemblies, which are optimised
+	// concurrently if they do not share any assembly, are all
+	// optimised and keep the tags referenced by the super-assembly.
+	// The last sub is also nested in the first one, so those two
+	// are optimised in order.
+
+	Assembly main;
+	vector<AssemblyPointer> subs;
+	for (size_t i = 0; i < 4; ++i)
+	{
+		AssemblyPointer sub = make_shared<Assembly>();
+		sub->append(u256(1));
+		sub->append(sub->newTag());
+		sub->append(u256(2));
+		sub->append(Instruction::JUMP);
+		sub->append(sub->newTag()); // Identical to the first tag, will be unified
+		sub->append(u256(2));
+		sub->append(Instruction::JUMP);
+		subs.push_back(sub);
+	}
+	subs[0]->appendSubroutine(subs[3]);
+	for (size_t i = 0; i < subs.size(); ++i)
+	{
+		size_t subId = size_t(main.appendSubroutine(subs[i]).data());
+		if (i < 3)
+			main.append(AssemblyItem(Tag, 1).toSubAssemblyTag(subId));
+	}
+
+	main.optimise(true, dev::test::Options::get().evmVersion(), false, 200);
+
+	AssemblyItems expectationMain;
+	for (size_t subId = 0; subId < subs.size(); ++subId)
+	{
+		expectationMain.push_back(AssemblyItem(PushSubSize, subId));
+		if (subId < 3)
+			expectationMain.push_back(AssemblyItem(Tag, 1).toSubAssemblyTag(subId).pushTag());
+	}
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		main.items().begin(), main.items().end(),
+		expectationMain.begin(), expectationMain.end()
+	);
+
+	AssemblyItems expectationSub{u256(1), AssemblyItem(Tag, 1), u256(2), Instruction::JUMP};
+	for (size_t subId = 1; subId < 3; ++subId)
+		BOOST_CHECK_EQUAL_COLLECTIONS(
+			subs[subId]->items().begin(), subs[subId]->items().end(),
+			expectationSub.begin(), expectationSub.end()
+		);
+}
+
 BOOST_AUTO_TEST_CASE(cse_sub_zero)
 {
 	checkCSE({
@@ -1370,6 +1422,130 @@ BOOST_AUTO_TEST_CASE(cse_replace_too_large_shift)
 	});
 }
 
+BOOST_AUTO_TEST_CASE(cse_storage_across_jumpi)
+{
+	// The value loaded before the conditional jump is still on the stack
+	// in both successors, so the loads there are removed.
+	Assembly main;
+	auto tag = main.newTag();
+	main.append(u256(0));
+	main.append(Instruction::SLOAD);
+	main.append(Instruction::DUP1);
+	main.append(tag.pushTag());
+	main.append(Instruction::JUMPI);
+	main.append(u256(0));
+	main.append(Instruction::SLOAD);
+	main.append(Instruction::ADD);
+	main.append(u256(1));
+	main.append(Instruction::SSTORE);
+	main.append(Instruction::STOP);
+	main.append(tag);
+	main.adjustDeposit(1);
+	main.append(u256(0));
+	main.append(Instruction::SLOAD);
+	main.append(Instruction::ADD);
+	main.append(u256(2));
+	main.append(Instruction::SSTORE);
+	main.append(Instruction::STOP);
+
+	main.optimise(true, dev::test::Options::get().evmVersion(), false, 200);
+
+	BOOST_CHECK_EQUAL(count(main.items().begin(), main.items().end(), AssemblyItem(Instruction::SLOAD)), 1);
+}
+
+BOOST_AUTO_TEST_CASE(cse_storage_at_join)
+{
+	// Both ways into the tag store the same value.
+	for (u256 value: {u256(5), u256(6)})
+	{
+		Assembly main;
+		auto tag = main.newTag();
+		main.append(u256(5));
+		main.append(u256(0));
+		main.append(Instruction::SSTORE);
+		main.append(Instruction::CALLVALUE);
+		main.append(tag.pushTag());
+		main.append(Instruction::JUMPI);
+		main.append(value);
+		main.append(u256(0));
+		main.append(Instruction::SSTORE);
+		main.append(tag);
+		main.append(u256(0));
+		main.append(Instruction::SLOAD);
+		main.append(u256(1));
+		main.append(Instruction::SSTORE);
+		main.append(Instruction::STOP);
+
+		main.optimise(true, dev::test::Options::get().evmVersion(), false, 200);
+
+		size_t loads = count(main.items().begin(), main.items().end(), AssemblyItem(Instruction::SLOAD));
+		BOOST_CHECK_EQUAL(loads, value == 5 ? 0 : 1);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(cse_storage_at_join_with_different_stack)
+{
+	// Stores to the slot given by the second stack element and, on the fall-through
+	// path, replaces that element by the top one before the join. The slot loaded
+	// after the join is only known to hold the stored value if it was not replaced.
+	for (bool replace: {false, true})
+	{
+		Assembly main;
+		auto tag = main.newTag();
+		main.append(u256(5));
+		main.append(Instruction::DUP3);
+		main.append(Instruction::SSTORE);
+		main.append(Instruction::CALLVALUE);
+		main.append(tag.pushTag());
+		main.append(Instruction::JUMPI);
+		if (replace)
+		{
+			main.append(Instruction::DUP1);
+			main.append(Instruction::SWAP2);
+			main.append(Instruction::POP);
+		}
+		main.append(tag);
+		main.append(Instruction::DUP2);
+		main.append(Instruction::SLOAD);
+		main.append(u256(1));
+		main.append(Instruction::SSTORE);
+		main.append(Instruction::STOP);
+
+		main.optimise(true, dev::test::Options::get().evmVersion(), false, 200);
+
+		size_t loads = count(main.items().begin(), main.items().end(), AssemblyItem(Instruction::SLOAD));
+		BOOST_CHECK_EQUAL(loads, replace ? 1 : 0);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(cse_storage_at_escaping_tag)
+{
+	// The tag is also stored in memory, so it might be the
+	// target of any jump and nothing is known at the tag.
+	Assembly main;
+	auto tag = main.newTag();
+	main.append(tag.pushTag());
+	main.append(u256(0));
+	main.append(Instruction::MSTORE);
+	main.append(u256(5));
+	main.append(u256(0));
+	main.append(Instruction::SSTORE);
+	main.append(Instruction::CALLVALUE);
+	main.append(tag.pushTag());
+	main.append(Instruction::JUMPI);
+	main.append(Instruction::STOP);
+	main.append(tag);
+	main.append(u256(0));
+	main.append(Instruction::SLOAD);
+	main.append(u256(1));
+	main.append(Instruction::SSTORE);
+	main.append(Instruction::STOP);
+
+	main.optimise(true, dev::test::Options::get().evmVersion(), false, 200);
+
+	BOOST_CHECK_EQUAL(count(main.items().begin(), main.items().end(), AssemblyItem(Instruction::SLOAD)), 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -18,6 +18,7 @@
 #include <test/libsolidity/ASTJSONTest.h>
 #include <test/Options.h>
 #include <libdevcore/AnsiColorized.h>
+#include <libdevcore/JSON.h>
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <boost/algorithm/string.hpp>
@@ -169,6 +170,30 @@ bool ASTJSONTest::run(ostream& _stream, string const& _linePrefix, bool const _f
 		resultsMatch = false;
 	}
 
+	// The non-legacy format is written while visiting, which has to give the same result
+	// as serialising the whole Json::Value tree.
+	for (auto const& source: m_sources)
+	{
+		SourceUnit const& ast = c.ast(source.first);
+		Json::Value tree = ASTJsonConverter(false, sourceIndices).toJson(ast);
+		ostringstream styledTree;
+		styledTree << tree;
+		ostringstream streamed;
+		ASTJsonConverter(false, sourceIndices).print(streamed, ast);
+		ostringstream streamedCompact;
+		ASTJsonConverter(false, sourceIndices).printCompact(streamedCompact, ast);
+		if (streamed.str() != styledTree.str())
+		{
+			AnsiColorized(_stream, _formatted, {BOLD, RED}) << _linePrefix << "Streamed AST of \"" << source.first << "\" differs from the serialised tree." << endl;
+			resultsMatch = false;
+		}
+		if (streamedCompact.str() != jsonCompactPrint(tree))
+		{
+			AnsiColorized(_stream, _formatted, {BOLD, RED}) << _linePrefix << "Compact streamed AST of \"" << source.first << "\" differs from the serialised tree." << endl;
+			resultsMatch = false;
+		}
+	}
+
 	return resultsMatch;
 }
 
@@ -0,0 +1,105 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * Unit tests for running several AST visitors in one traversal.
+ */
+
+#include <test/libsolidity/AnalysisFramework.h>
+
+#include <libsolidity/ast/ASTVisitor.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+namespace
+{
+
+/// Records the visited nodes and does not descend into the nodes of the given type.
+template <class Skipped>
+class RecordingVisitor: public ASTConstVisitor
+{
+public:
+	vector<ASTNode const*> visited;
+	vector<ASTNode const*> endVisited;
+
+protected:
+	bool visitNode(ASTNode const& _node) override
+	{
+		visited.push_back(&_node);
+		return !dynamic_cast<Skipped const*>(&_node);
+	}
+	void endVisitNode(ASTNode const& _node) override
+	{
+		endVisited.push_back(&_node);
+	}
+};
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(SolidityASTVisitor, AnalysisFramework)
+
+BOOST_AUTO_TEST_CASE(composite_visitor)
+{
+	char const* sourceCode = R"(
+		contract C {
+			uint x;
+			function f(uint a) public returns (uint) { if (a > 2) return a; x = a; }
+			modifier m { _; }
+		}
+		contract D is C {
+			function g() public { f(1); }
+		}
+	)";
+	SourceUnit const* sourceUnit = parseAndAnalyse(sourceCode);
+	BOOST_REQUIRE(sourceUnit);
+
+	RecordingVisitor<FunctionDefinition> skipFunctions;
+	RecordingVisitor<Block> skipBlocks;
+	RecordingVisitor<ContractDefinition> skipContracts;
+	sourceUnit->accept(skipFunctions);
+	sourceUnit->accept(skipBlocks);
+	sourceUnit->accept(skipContracts);
+
+	RecordingVisitor<FunctionDefinition> composedSkipFunctions;
+	RecordingVisitor<Block> composedSkipBlocks;
+	RecordingVisitor<ContractDefinition> composedSkipContracts;
+	CompositeASTConstVisitor composite({&composedSkipFunctions, &composedSkipBlocks, &composedSkipContracts});
+	sourceUnit->accept(composite);
+
+	BOOST_CHECK(composedSkipFunctions.visited == skipFunctions.visited);
+	BOOST_CHECK(composedSkipFunctions.endVisited == skipFunctions.endVisited);
+	BOOST_CHECK(composedSkipBlocks.visited == skipBlocks.visited);
+	BOOST_CHECK(composedSkipBlocks.endVisited == skipBlocks.endVisited);
+	BOOST_CHECK(composedSkipContracts.visited == skipContracts.visited);
+	BOOST_CHECK(composedSkipContracts.endVisited == skipContracts.endVisited);
+	BOOST_CHECK(skipFunctions.visited.size() < skipBlocks.visited.size());
+	BOOST_CHECK(skipContracts.visited.size() < skipFunctions.visited.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+}
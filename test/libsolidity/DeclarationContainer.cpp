@@ -0,0 +1,92 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the declaration container and its lookup cache.
+ */
+
+#include <libsolidity/analysis/DeclarationContainer.h>
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/Types.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(SolidityDeclarationContainer)
+
+BOOST_AUTO_TEST_CASE(register_in_outer_container_after_cached_lookup)
+{
+	MagicVariableDeclaration outerX("x", make_shared<IntegerType>(256));
+	MagicVariableDeclaration middleX("x", make_shared<IntegerType>(256));
+	DeclarationContainer outer;
+	DeclarationContainer middle(nullptr, &outer);
+	DeclarationContainer inner(nullptr, &middle);
+
+	BOOST_CHECK(inner.resolveName("x", true).empty());
+
+	BOOST_REQUIRE(outer.registerDeclaration(outerX));
+	BOOST_CHECK(inner.resolveName("x", true) == vector<Declaration const*>{&outerX});
+	// Repeated lookup is served from the cache.
+	BOOST_CHECK(inner.resolveName("x", true) == vector<Declaration const*>{&outerX});
+
+	BOOST_REQUIRE(middle.registerDeclaration(middleX));
+	BOOST_CHECK(inner.resolveName("x", true) == vector<Declaration const*>{&middleX});
+	BOOST_CHECK(middle.resolveName("x", true) == vector<Declaration const*>{&middleX});
+	BOOST_CHECK(inner.resolveName("x", false).empty());
+}
+
+BOOST_AUTO_TEST_CASE(activate_in_outer_container_after_cached_lookup)
+{
+	MagicVariableDeclaration x("x", make_shared<IntegerType>(256));
+	DeclarationContainer outer;
+	DeclarationContainer inner(nullptr, &outer);
+
+	BOOST_REQUIRE(outer.registerDeclaration(x, nullptr, true));
+	BOOST_CHECK(inner.resolveName("x", true).empty());
+	BOOST_CHECK(inner.resolveName("x", true, true) == vector<Declaration const*>{&x});
+
+	outer.activateVariable("x");
+	BOOST_CHECK(inner.resolveName("x", true) == vector<Declaration const*>{&x});
+}
+
+BOOST_AUTO_TEST_CASE(change_in_sibling_keeps_lookup)
+{
+	MagicVariableDeclaration outerX("x", make_shared<IntegerType>(256));
+	MagicVariableDeclaration siblingX("x", make_shared<IntegerType>(256));
+	DeclarationContainer outer;
+	DeclarationContainer left(nullptr, &outer);
+	DeclarationContainer right(nullptr, &outer);
+
+	BOOST_REQUIRE(outer.registerDeclaration(outerX));
+	BOOST_CHECK(left.resolveName("x", true) == vector<Declaration const*>{&outerX});
+	BOOST_REQUIRE(right.registerDeclaration(siblingX));
+	BOOST_CHECK(left.resolveName("x", true) == vector<Declaration const*>{&outerX});
+	BOOST_CHECK(right.resolveName("x", true) == vector<Declaration const*>{&siblingX});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+}
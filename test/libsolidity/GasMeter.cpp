@@ -200,6 +200,25 @@ BOOST_AUTO_TEST_CASE(updating_store)
 	testCreationTimeGas(sourceCode, m_evmVersion < EVMVersion::constantinople() ? u256(0) : u256(9600));
 }
 
+BOOST_AUTO_TEST_CASE(packed_struct_assignment)
+{
+	char const* sourceCode = R"(
+		contract test {
+			struct Order { uint64 price; uint64 amount; address owner; bool active; uint64 expiry; }
+			mapping(uint => Order) orders;
+			function f(uint id, uint64 price, uint64 amount) public {
+				orders[id] = Order(price, amount, msg.sender, true, 7);
+			}
+		}
+	)";
+	testCreationTimeGas(sourceCode);
+	testRunTimeGas("f(uint256,uint64,uint64)", vector<bytes>{
+		encodeArgs(1, 2, 3),
+		encodeArgs(1, 0, 0),
+		encodeArgs(2, 3, 4)
+	});
+}
+
 BOOST_AUTO_TEST_CASE(branches)
 {
 	char const* sourceCode = R"(
@@ -261,6 +280,41 @@ BOOST_AUTO_TEST_CASE(multiple_external_functions)
 	testRunTimeGas("g(uint256)", vector<bytes>{encodeArgs(2)});
 }
 
+BOOST_AUTO_TEST_CASE(batched_functional_estimation)
+{
+	char const* sourceCode = R"(
+		contract test {
+			uint data;
+			uint data2;
+			function f(uint x) public {
+				if (x > 7)
+					data2 = g(x**8) + 1;
+				else
+					data = 1;
+			}
+			function g(uint x) public returns (uint) {
+				return data2 + x;
+			}
+			function h(bytes32 x) public returns (bytes32) {
+				return keccak256(abi.encodePacked(x, data));
+			}
+			function() external { data = 2; }
+		}
+	)";
+	compile(sourceCode);
+	AssemblyItems const& items = *m_compiler.runtimeAssemblyItems(m_compiler.lastContractName());
+	GasEstimator estimator(dev::test::Options::get().evmVersion());
+	vector<string> signatures{"f(uint256)", "g(uint256)", "h(bytes32)", "INVALID"};
+	vector<GasMeter::GasConsumption> batched = estimator.functionalEstimations(items, signatures);
+	BOOST_REQUIRE_EQUAL(batched.size(), signatures.size());
+	for (size_t i = 0; i < signatures.size(); ++i)
+	{
+		GasMeter::GasConsumption single = estimator.functionalEstimation(items, signatures[i]);
+		BOOST_CHECK_EQUAL(batched[i].isInfinite, single.isInfinite);
+		BOOST_CHECK_EQUAL(batched[i].value, single.value);
+	}
+}
+
 BOOST_AUTO_TEST_CASE(exponent_size)
 {
 	char const* sourceCode = R"(
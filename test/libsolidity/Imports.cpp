@@ -542,6 +542,47 @@ BOOST_AUTO_TEST_CASE(inheritance_abi_encoder_match)
 	BOOST_CHECK_EQUAL(typeErrors, 0);
 }
 
+BOOST_AUTO_TEST_CASE(errors_of_multiple_sources_are_deterministic)
+{
+	// Warnings from all analysis stages in several sources, then errors that stop
+	// the analysis early.
+	StringMap warnings{
+		{"a", "contract A { function f() public { uint x; } }"},
+		{"b", "import \"a\"; contract B is A { function g() public view returns (uint) { return 1; } }"},
+		{"c", "pragma solidity >=0.0; import \"b\"; contract C is B { uint constant x = 2; function h() public { uint y; } }"},
+		{"d", "import \"c\"; contract D { function i(uint z) public returns (uint) { } }"}
+	};
+	StringMap errors = warnings;
+	errors["a"] = "contract A { /// @author x\n function f() public { } }";
+	errors["c"] = "pragma solidity >=0.0; import \"b\"; contract C is B { function h() public { uint[0] y; y; } }";
+	for (StringMap const& sources: {warnings, errors})
+	{
+		auto analyse = [&]()
+		{
+			CompilerStack c;
+			c.setSources(sources);
+			c.setEVMVersion(dev::test::Options::get().evmVersion());
+			c.parseAndAnalyze();
+			vector<string> result;
+			for (auto const& error: c.errors())
+			{
+				string formatted = error->typeName() + " " + *boost::get_error_info<errinfo_comment>(*error);
+				auto location = boost::get_error_info<langutil::errinfo_sourceLocation>(*error);
+				if (location && location->source)
+					formatted +=
+						" at " + location->source->name() + ":" +
+						to_string(location->start) + "-" + to_string(location->end);
+				result.push_back(formatted);
+			}
+			return result;
+		};
+		vector<string> const expectation = analyse();
+		BOOST_CHECK(expectation.size() >= 4);
+		for (size_t i = 0; i < 20; ++i)
+			BOOST_CHECK(analyse() == expectation);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
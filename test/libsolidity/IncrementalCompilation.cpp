@@ -0,0 +1,241 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for reusing the generated code of unchanged contracts across compilations.
+ */
+
+#include <test/Options.h>
+
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <libdevcore/JSON.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+namespace
+{
+
+void compile(CompilerStack& _compilerStack, StringMap const& _sources)
+{
+	_compilerStack.reset(true);
+	_compilerStack.setSources(_sources);
+	BOOST_REQUIRE_MESSAGE(_compilerStack.compile(), "Compiling contract failed");
+}
+
+/// Checks that the outputs of @a _compilerStack are the same as the ones of compiling
+/// @a _sources from scratch.
+void checkSameAsFreshCompilation(CompilerStack const& _compilerStack, StringMap const& _sources)
+{
+	CompilerStack freshCompilerStack;
+	freshCompilerStack.setEVMVersion(dev::test::Options::get().evmVersion());
+	freshCompilerStack.setOptimiserSettings(dev::test::Options::get().optimize);
+	compile(freshCompilerStack, _sources);
+	SharedStringMap sharedSources;
+	for (auto const& source: _sources)
+		sharedSources[source.first] = make_shared<string const>(source.second);
+	BOOST_CHECK(_compilerStack.contractNames() == freshCompilerStack.contractNames());
+	for (string const& name: freshCompilerStack.contractNames())
+	{
+		BOOST_CHECK_MESSAGE(
+			_compilerStack.object(name).bytecode == freshCompilerStack.object(name).bytecode,
+			"Different bytecode for " + name
+		);
+		BOOST_CHECK_MESSAGE(
+			_compilerStack.runtimeObject(name).bytecode == freshCompilerStack.runtimeObject(name).bytecode,
+			"Different runtime bytecode for " + name
+		);
+		BOOST_CHECK_EQUAL(
+			jsonCompactPrint(_compilerStack.gasEstimates(name)),
+			jsonCompactPrint(freshCompilerStack.gasEstimates(name))
+		);
+		BOOST_CHECK_EQUAL(_compilerStack.assemblyString(name, sharedSources), freshCompilerStack.assemblyString(name, sharedSources));
+		BOOST_CHECK_EQUAL(
+			jsonCompactPrint(_compilerStack.assemblyJSON(name, sharedSources)),
+			jsonCompactPrint(freshCompilerStack.assemblyJSON(name, sharedSources))
+		);
+	}
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(IncrementalCompilation)
+
+BOOST_AUTO_TEST_CASE(library_implementation_change)
+{
+	StringMap sources;
+	sources["lib.sol"] = R"(
+		library L {
+			function f(uint x) public pure returns (uint) { return x + 1; }
+			function g(uint x) internal pure returns (uint) { return x * 2; }
+		}
+	)";
+	sources["a.sol"] = R"(
+		import "lib.sol";
+		contract A {
+			function h(uint x) public pure returns (uint) { return i(x); }
+			function i(uint x) internal pure returns (uint) { return L.f(x); }
+		}
+	)";
+	sources["b.sol"] = R"(
+		import "lib.sol";
+		contract B {
+			function h(uint x) public pure returns (uint) { return L.g(x); }
+		}
+	)";
+	sources["c.sol"] = "contract C { function h() public pure returns (uint) { return 7; } }";
+	CompilerStack compilerStack;
+	compilerStack.setEVMVersion(dev::test::Options::get().evmVersion());
+	compilerStack.setOptimiserSettings(dev::test::Options::get().optimize);
+	compile(compilerStack, sources);
+	BOOST_CHECK(compilerStack.generatedContractNames() == (set<string>{"lib.sol:L", "a.sol:A", "b.sol:B", "c.sol:C"}));
+
+	compile(compilerStack, sources);
+	BOOST_CHECK(compilerStack.generatedContractNames().empty());
+	checkSameAsFreshCompilation(compilerStack, sources);
+
+	// A only calls the external function of the library and is not affected by its body,
+	// B uses an internal function of the library, whose code is part of B.
+	sources["lib.sol"] = R"(
+		library L {
+			function f(uint x) public pure returns (uint) { return x + 2; }
+			function g(uint x) internal pure returns (uint) { return x * 2; }
+		}
+	)";
+	compile(compilerStack, sources);
+	BOOST_CHECK(compilerStack.generatedContractNames() == (set<string>{"lib.sol:L", "b.sol:B"}));
+	checkSameAsFreshCompilation(compilerStack, sources);
+
+	// Changing the signature changes the interface the code of A depends on.
+	sources["lib.sol"] = R"(
+		library L {
+			function f(uint x) public pure returns (uint64) { return uint64(x + 2); }
+			function g(uint x) internal pure returns (uint) { return x * 2; }
+		}
+	)";
+	compile(compilerStack, sources);
+	BOOST_CHECK(compilerStack.generatedContractNames() == (set<string>{"lib.sol:L", "a.sol:A", "b.sol:B"}));
+	checkSameAsFreshCompilation(compilerStack, sources);
+}
+
+BOOST_AUTO_TEST_CASE(base_contract_change)
+{
+	StringMap sources;
+	sources["base.sol"] = R"(
+		contract Base { uint x; function f() public { x = 1; } }
+		contract Other { function g() public pure returns (uint) { return 1; } }
+	)";
+	sources["derived.sol"] = R"(
+		import "base.sol";
+		contract Derived is Base { function h() public view returns (uint) { return x; } }
+	)";
+	CompilerStack compilerStack;
+	compilerStack.setEVMVersion(dev::test::Options::get().evmVersion());
+	compilerStack.setOptimiserSettings(dev::test::Options::get().optimize);
+	compile(compilerStack, sources);
+
+	sources["base.sol"] = R"(
+		contract Base { uint x; function f() public { x = 1; } }
+		contract Other { function g() public pure returns (uint) { return 2; } }
+	)";
+	compile(compilerStack, sources);
+	BOOST_CHECK(compilerStack.generatedContractNames() == (set<string>{"base.sol:Other"}));
+	checkSameAsFreshCompilation(compilerStack, sources);
+
+	sources["base.sol"] = R"(
+		contract Base { uint x; function f() public { x = 3; } }
+		contract Other { function g() public pure returns (uint) { return 2; } }
+	)";
+	compile(compilerStack, sources);
+	BOOST_CHECK(compilerStack.generatedContractNames() == (set<string>{"base.sol:Base", "derived.sol:Derived"}));
+	checkSameAsFreshCompilation(compilerStack, sources);
+}
+
+BOOST_AUTO_TEST_CASE(created_contract)
+{
+	StringMap sources;
+	sources["d.sol"] = R"(
+		contract D { uint public x = 1; }
+		contract Other { function g() public pure returns (uint) { return 1; } }
+	)";
+	sources["e.sol"] = R"(
+		import "d.sol";
+		contract E { function f() public returns (D) { return new D(); } }
+	)";
+	sources["f.sol"] = R"(
+		import "e.sol";
+		contract F { function f() public returns (E) { return new E(); } }
+	)";
+	CompilerStack compilerStack;
+	compilerStack.setEVMVersion(dev::test::Options::get().evmVersion());
+	compilerStack.setOptimiserSettings(dev::test::Options::get().optimize);
+	compile(compilerStack, sources);
+
+	// The metadata of all contracts changes, but only Other has to be generated again.
+	sources["d.sol"] = R"(
+		contract D { uint public x = 1; }
+		contract Other { function g() public pure returns (uint) { return 2; } }
+	)";
+	compile(compilerStack, sources);
+	BOOST_CHECK(compilerStack.generatedContractNames() == (set<string>{"d.sol:Other"}));
+	checkSameAsFreshCompilation(compilerStack, sources);
+
+	// Changing E requires generating the contracts it creates and that create it.
+	sources["e.sol"] = R"(
+		import "d.sol";
+		contract E { function f() public returns (D) { return new D(); } function g() public {} }
+	)";
+	compile(compilerStack, sources);
+	BOOST_CHECK(compilerStack.generatedContractNames() == (set<string>{"d.sol:D", "e.sol:E", "f.sol:F"}));
+	checkSameAsFreshCompilation(compilerStack, sources);
+}
+
+BOOST_AUTO_TEST_CASE(settings_change)
+{
+	StringMap sources{{"c.sol", "contract C { function f() public pure returns (uint) { return 1; } }"}};
+	CompilerStack compilerStack;
+	compilerStack.setEVMVersion(dev::test::Options::get().evmVersion());
+	compilerStack.setOptimiserSettings(false);
+	compile(compilerStack, sources);
+
+	compilerStack.reset(true);
+	compilerStack.setOptimiserSettings(true);
+	compilerStack.setSources(sources);
+	BOOST_REQUIRE(compilerStack.compile());
+	BOOST_CHECK(compilerStack.generatedContractNames() == (set<string>{"c.sol:C"}));
+
+	compilerStack.reset();
+	compilerStack.setEVMVersion(dev::test::Options::get().evmVersion());
+	compilerStack.setOptimiserSettings(true);
+	compilerStack.setSources(sources);
+	BOOST_REQUIRE(compilerStack.compile());
+	BOOST_CHECK(compilerStack.generatedContractNames() == (set<string>{"c.sol:C"}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+}
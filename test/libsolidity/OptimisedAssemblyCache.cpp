@@ -0,0 +1,175 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the process-wide cache of optimised compiler-generated assembly.
+ */
+
+#include <test/Options.h>
+
+#include <libsolidity/codegen/CompilerContext.h>
+#include <libsolidity/codegen/OptimisedAssemblyCache.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <libyul/AsmData.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+namespace
+{
+
+/// @returns the bytecode of all contracts in @a _source compiled with the full optimiser.
+map<string, bytes> compileOptimised(string const& _source)
+{
+	CompilerStack compilerStack;
+	compilerStack.setEVMVersion(dev::test::Options::get().evmVersion());
+	compilerStack.setOptimiserSettings(OptimiserSettings::full());
+	compilerStack.setSources({{"", _source}});
+	BOOST_REQUIRE_MESSAGE(compilerStack.compile(), "Compiling contract failed");
+	map<string, bytes> bytecode;
+	for (string const& name: compilerStack.contractNames())
+		bytecode[name] = compilerStack.object(name).bytecode;
+	return bytecode;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(OptimisedAssemblyCaching)
+
+BOOST_AUTO_TEST_CASE(cold_and_warm_cache_yield_same_bytecode)
+{
+	string const source = R"(
+		pragma experimental ABIEncoderV2;
+		contract C {
+			struct S { uint a; uint[] b; }
+			function f(S memory s, uint[2][] memory t) public pure returns (S memory, uint) {
+				return (s, t.length);
+			}
+		}
+		contract D {
+			function g(bytes memory b, string memory s) public pure returns (bytes memory, string memory) {
+				return (b, s);
+			}
+		}
+	)";
+	OptimisedAssemblyCache::instance().clear();
+	map<string, bytes> cold = compileOptimised(source);
+	BOOST_CHECK(OptimisedAssemblyCache::instance().size() > 0);
+	size_t entries = OptimisedAssemblyCache::instance().size();
+	map<string, bytes> warm = compileOptimised(source);
+	BOOST_CHECK_EQUAL(OptimisedAssemblyCache::instance().size(), entries);
+	BOOST_CHECK(cold == warm);
+}
+
+BOOST_AUTO_TEST_CASE(different_settings_do_not_share_entries)
+{
+	OptimisedAssemblyCache& cache = OptimisedAssemblyCache::instance();
+	cache.clear();
+	string const assembly = "{ function f(a) -> b { b := add(a, 1) } }";
+	set<yul::YulString> const identifiers{yul::YulString{"f"}};
+	OptimiserSettings const settings = OptimiserSettings::full();
+	OptimiserSettings withoutStackOptimisation = settings;
+	withoutStackOptimisation.optimizeStackAllocation = false;
+	OptimiserSettings withOtherRuns = settings;
+	withOtherRuns.expectedExecutionsPerDeployment = 1;
+	h256 const key = OptimisedAssemblyCache::key(assembly, langutil::EVMVersion::byzantium(), settings, identifiers);
+	vector<h256> const otherKeys{
+		OptimisedAssemblyCache::key(assembly, langutil::EVMVersion::constantinople(), settings, identifiers),
+		OptimisedAssemblyCache::key(assembly, langutil::EVMVersion::byzantium(), withoutStackOptimisation, identifiers),
+		OptimisedAssemblyCache::key(assembly, langutil::EVMVersion::byzantium(), withOtherRuns, identifiers),
+		OptimisedAssemblyCache::key(assembly, langutil::EVMVersion::byzantium(), settings, {}),
+		OptimisedAssemblyCache::key(assembly, langutil::EVMVersion::byzantium(), settings, {yul::YulString{"g"}}),
+		OptimisedAssemblyCache::key(assembly + " ", langutil::EVMVersion::byzantium(), settings, identifiers)
+	};
+	BOOST_CHECK(key == OptimisedAssemblyCache::key(assembly, langutil::EVMVersion::byzantium(), settings, identifiers));
+	BOOST_CHECK_EQUAL(set<h256>(otherKeys.begin(), otherKeys.end()).size(), otherKeys.size());
+
+	auto block = make_shared<yul::Block const>();
+	cache.insert(key, block);
+	BOOST_CHECK(cache.find(key) == block);
+	for (h256 const& otherKey: otherKeys)
+	{
+		BOOST_CHECK(otherKey != key);
+		BOOST_CHECK(!cache.find(otherKey));
+	}
+	cache.clear();
+}
+
+BOOST_AUTO_TEST_CASE(different_runs_do_not_share_entries)
+{
+	// The optimiser specializes f for the constant argument only if the code is executed often enough.
+	string const assembly = R"({
+		function f(a, b) -> r {
+			let x := div(a, b)
+			if gt(b, 3) { x := add(x, mul(b, 17)) }
+			if lt(b, 5) { x := sub(x, exp(b, 3)) }
+			r := add(x, mod(a, b))
+		}
+		mstore(0, f(calldataload(0), 7))
+		mstore(32, f(calldataload(32), 7))
+		mstore(64, f(calldataload(64), calldataload(96)))
+	})";
+	auto compile = [&](size_t _runs)
+	{
+		OptimiserSettings settings = OptimiserSettings::full();
+		settings.expectedExecutionsPerDeployment = _runs;
+		CompilerContext context(dev::test::Options::get().evmVersion());
+		context.appendInlineAssembly(assembly, {}, {}, false, settings);
+		return context.assembledObject().bytecode;
+	};
+	OptimisedAssemblyCache& cache = OptimisedAssemblyCache::instance();
+
+	cache.clear();
+	bytes const coldRarelyRun = compile(1);
+	bytes const coldOftenRun = compile(200);
+	BOOST_REQUIRE(coldRarelyRun != coldOftenRun);
+
+	cache.clear();
+	BOOST_CHECK(compile(1) == coldRarelyRun);
+	BOOST_CHECK_EQUAL(cache.size(), 1);
+	BOOST_CHECK(compile(200) == coldOftenRun);
+	BOOST_CHECK_EQUAL(cache.size(), 2);
+	BOOST_CHECK(compile(1) == coldRarelyRun);
+	BOOST_CHECK_EQUAL(cache.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(string_repository_reset_clears_cache)
+{
+	OptimisedAssemblyCache& cache = OptimisedAssemblyCache::instance();
+	cache.clear();
+	cache.insert(
+		OptimisedAssemblyCache::key("{}", langutil::EVMVersion{}, OptimiserSettings::full(), {}),
+		make_shared<yul::Block const>()
+	);
+	BOOST_CHECK_EQUAL(cache.size(), 1);
+	yul::YulStringRepository::instance().reset();
+	BOOST_CHECK_EQUAL(cache.size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+}
@@ -22,6 +22,10 @@
 #include <test/Metadata.h>
 #include <test/Options.h>
 
+#include <libevmasm/AssemblyItem.h>
+
+#include <algorithm>
+
 using namespace std;
 
 namespace dev
@@ -53,6 +57,35 @@ BOOST_AUTO_TEST_CASE(does_not_include_creation_time_only_internal_functions)
 	BOOST_CHECK(runtimeBytecode.size() <= 30);
 }
 
+BOOST_AUTO_TEST_CASE(packed_struct_assignment_writes_each_slot_once)
+{
+	char const* sourceCode = R"(
+		contract C {
+			struct S { uint64 a; bytes3 b; bool c; mapping(uint => uint) m; address d; int8 e; uint f; }
+			S s;
+			S t;
+			function f(uint64 a) public { s = S(a, "abc", true, msg.sender, -1, 2); }
+			function g() public { t = s; }
+		}
+	)";
+	// Not running the optimiser, which would also combine these writes.
+	m_compiler.setOptimiserSettings(false);
+	BOOST_REQUIRE(success(sourceCode));
+	BOOST_REQUIRE_MESSAGE(m_compiler.compile(), "Compiling contract failed");
+	eth::AssemblyItems const* items = m_compiler.runtimeAssemblyItems("C");
+	BOOST_REQUIRE(items);
+	auto count = [&](eth::Instruction _instruction) {
+		return count_if(items->begin(), items->end(), [&](eth::AssemblyItem const& _item) {
+			return _item == eth::AssemblyItem(_instruction);
+		});
+	};
+	// Three slots are written by each function: (a, b, c), (d, e) and f.
+	BOOST_CHECK_EQUAL(count(eth::Instruction::SSTORE), 6);
+	// The two partially written slots are loaded once per function, and g
+	// reads each of the six members of s separately.
+	BOOST_CHECK_EQUAL(count(eth::Instruction::SLOAD), 2 + 2 + 6);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -648,6 +648,60 @@ BOOST_AUTO_TEST_CASE(irregular_line_breaks_in_strings)
 	}
 }
 
+BOOST_AUTO_TEST_CASE(long_runs_with_multibyte_characters)
+{
+	// Whitespace, comments and strings are skipped in blocks of 16 characters,
+	// these cross block boundaries and contain lead bytes of unicode line breaks.
+	string const filler = "abc \xC3\xA4 \xE2\x82\xAC \xC2\xA0 * / xyz abc \xE2\x80 def";
+	Scanner scanner(CharStream(
+		"a" + string(37, ' ') + "\t\r\n" +
+		"// " + filler + filler + "\n" +
+		"/* " + filler + "\n" + filler + " **/" +
+		"b \"" + filler + "\\x41" + filler + "\" c",
+		""
+	));
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "a");
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "b");
+	BOOST_CHECK_EQUAL(scanner.next(), Token::StringLiteral);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), filler + "A" + filler);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "c");
+	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
+}
+
+BOOST_AUTO_TEST_CASE(keywords_and_sized_types)
+{
+	Scanner scanner(CharStream(
+		"contract contracts uint uint8 uint256 uint264 uint7 bytes32 bytes33 "
+		"fixed128x18 ufixed8x80 ufixed8x81 fixed8x int99999999999 unchecked x",
+		""
+	));
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Contract);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::UInt);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::UIntM);
+	BOOST_CHECK_EQUAL(get<0>(scanner.currentTokenInfo()), 8);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::UIntM);
+	BOOST_CHECK_EQUAL(get<0>(scanner.currentTokenInfo()), 256);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::BytesM);
+	BOOST_CHECK_EQUAL(get<0>(scanner.currentTokenInfo()), 32);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::FixedMxN);
+	BOOST_CHECK_EQUAL(get<0>(scanner.currentTokenInfo()), 128);
+	BOOST_CHECK_EQUAL(get<1>(scanner.currentTokenInfo()), 18);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::UFixedMxN);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Unchecked);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
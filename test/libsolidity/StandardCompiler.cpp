@@ -604,6 +604,45 @@ BOOST_AUTO_TEST_CASE(output_selection_dependent_contract_with_import)
 	BOOST_CHECK_EQUAL(dev::jsonCompactPrint(contract["abi"]), "[{\"constant\":false,\"inputs\":[],\"name\":\"f\",\"outputs\":[],\"payable\":false,\"stateMutability\":\"nonpayable\",\"type\":\"function\"}]");
 }
 
+BOOST_AUTO_TEST_CASE(output_selection_skips_codegen_for_non_binary_outputs)
+{
+	// Compiling A fails with "stack too deep", so it must not be compiled
+	// if only outputs that do not need code generation are requested for it.
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"*": {
+					"*": ["abi", "metadata", "evm.methodIdentifiers"]
+				},
+				"fileA": {
+					"B": ["evm.bytecode.object"]
+				}
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f(uint a0, uint a1, uint a2, uint a3, uint a4, uint a5, uint a6, uint a7, uint a8, uint a9, uint a10, uint a11, uint a12, uint a13, uint a14, uint a15, uint a16, uint a17, uint a18, uint a19) public pure returns (uint) { return a0; } } contract B { function g() public {} }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	BOOST_CHECK(contract["abi"].isArray());
+	BOOST_CHECK(contract["metadata"].isString());
+	BOOST_CHECK(contract["evm"]["methodIdentifiers"].isObject());
+	BOOST_CHECK(!contract["evm"].isMember("bytecode"));
+	contract = getContractResult(result, "fileA", "B");
+	BOOST_CHECK(contract.isObject());
+	BOOST_CHECK(contract["abi"].isArray());
+	BOOST_CHECK(contract["evm"]["bytecode"]["object"].isString());
+	BOOST_CHECK(!contract["evm"].isMember("deployedBytecode"));
+}
+
 BOOST_AUTO_TEST_CASE(filename_with_colon)
 {
 	char const* input = R"(
@@ -1156,6 +1195,49 @@ BOOST_AUTO_TEST_CASE(use_stack_optimization)
 	BOOST_CHECK(result["errors"][0]["type"] == "InternalCompilerError");
 }
 
+BOOST_AUTO_TEST_CASE(serialised_output_is_identical_to_json_output)
+{
+	// The string interface writes the ASTs while visiting, the JSON interface builds a tree.
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"*": {
+					"": [ "ast", "legacyAST" ],
+					"*": [ "abi", "evm.bytecode.object" ]
+				},
+				"b.sol": { "": [ "ast" ] }
+			}
+		},
+		"sources": {
+			"a.sol": {
+				"content": "pragma solidity >=0.0; contract A { uint x; function f() public returns (uint) { return x; } } contract B is A { event E(uint); }"
+			},
+			"b.sol": {
+				"content": "pragma solidity >=0.0; import \"a.sol\"; library L { struct S { uint y; } } contract C is B { using L for uint; }"
+			},
+			"dir/\"quoted\".sol": {
+				"content": "pragma solidity >=0.0; import \"b.sol\";"
+			}
+		}
+	}
+	)";
+	Json::Value parsedInput;
+	BOOST_REQUIRE(jsonParseStrict(input, parsedInput));
+	dev::solidity::StandardCompiler compiler;
+	Json::Value result = compiler.compile(parsedInput);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(result["sources"]["b.sol"]["ast"]["nodes"].size() == 4);
+	BOOST_CHECK_EQUAL(compiler.compile(string(input)), jsonCompactPrint(result));
+
+	// Without successful analysis, the sources are empty.
+	parsedInput["sources"]["a.sol"]["content"] = "contract A { uint x = y; }";
+	result = compiler.compile(parsedInput);
+	BOOST_CHECK(result["sources"].isObject() && result["sources"].empty());
+	BOOST_CHECK_EQUAL(compiler.compile(jsonCompactPrint(parsedInput)), jsonCompactPrint(result));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -0,0 +1,19 @@
+library L {
+	function double(uint _x) internal pure returns (uint) { return 2 * _x; }
+	function size(uint[] storage _x) internal view returns (uint) { return _x.length; }
+}
+library M {
+	function triple(uint _x) internal pure returns (uint) { return 3 * _x; }
+	function first(uint[] memory _x) internal pure returns (uint) { return _x[0]; }
+}
+contract A {
+	using L for uint;
+	using L for uint[];
+}
+contract B is A {
+	using M for *;
+	uint[] s;
+	function f(uint[] memory _m) public view returns (uint) {
+		return uint(1).double().triple() + s.size() + _m.first() + s.first();
+	}
+}
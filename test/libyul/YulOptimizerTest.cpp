@@ -23,6 +23,7 @@
 #include <libyul/optimiser/VarDeclInitializer.h>
 #include <libyul/optimiser/VarNameCleaner.h>
 #include <libyul/optimiser/Disambiguator.h>
+#include <libyul/optimiser/DeadStoreEliminator.h>
 #include <libyul/optimiser/CommonSubexpressionEliminator.h>
 #include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/EquivalentFunctionCombiner.h>
@@ -32,6 +33,8 @@
 #include <libyul/optimiser/ExpressionInliner.h>
 #include <libyul/optimiser/FullInliner.h>
 #include <libyul/optimiser/ForLoopInitRewriter.h>
+#include <libyul/optimiser/FunctionSpecialiser.h>
+#include <libyul/optimiser/LoopInvariantCodeMotion.h>
 #include <libyul/optimiser/MainFunction.h>
 #include <libyul/optimiser/Rematerialiser.h>
 #include <libyul/optimiser/ExpressionSimplifier.h>
@@ -118,6 +121,12 @@ bool YulOptimizerTest::run(ostream& _stream, string const& _linePrefix, bool con
 		disambiguate();
 		ForLoopInitRewriter{}(*m_ast);
 	}
+	else if (m_optimizerStep == "loopInvariantCodeMotion")
+	{
+		disambiguate();
+		ForLoopInitRewriter{}(*m_ast);
+		LoopInvariantCodeMotion::run(*m_dialect, *m_ast);
+	}
 	else if (m_optimizerStep == "commonSubexpressionEliminator")
 	{
 		disambiguate();
@@ -166,6 +175,14 @@ bool YulOptimizerTest::run(ostream& _stream, string const& _linePrefix, bool con
 		FullInliner(*m_ast, nameDispenser).run();
 		ExpressionJoiner::run(*m_ast);
 	}
+	else if (m_optimizerStep == "functionSpecialiser")
+	{
+		disambiguate();
+		(FunctionHoister{})(*m_ast);
+		(FunctionGrouper{})(*m_ast);
+		NameDispenser nameDispenser{*m_dialect, *m_ast};
+		FunctionSpecialiser::run(*m_dialect, *m_ast, nameDispenser, 200);
+	}
 	else if (m_optimizerStep == "mainFunction")
 	{
 		disambiguate();
@@ -226,6 +243,11 @@ bool YulOptimizerTest::run(ostream& _stream, string const& _linePrefix, bool con
 		disambiguate();
 		EquivalentFunctionCombiner::run(*m_ast);
 	}
+	else if (m_optimizerStep == "deadStoreEliminator")
+	{
+		disambiguate();
+		DeadStoreEliminator::run(*m_dialect, *m_ast);
+	}
 	else if (m_optimizerStep == "ssaReverser")
 	{
 		disambiguate();
@@ -19,6 +19,7 @@
 */
 
 #include <test/tools/IsolTestOptions.h>
+#include <libdevcore/Assertions.h>
 #include <boost/filesystem.hpp>
 #include <string>
 #include <iostream>
@@ -53,7 +54,9 @@ IsolTestOptions::IsolTestOptions(std::string* _editor):
 	options.add_options()
 		("help", po::bool_switch(&showHelp), "Show this help screen.")
 		("no-color", po::bool_switch(&noColor), "don't use colors")
-		("editor", po::value<std::string>(_editor)->default_value(editorPath()), "editor for opening test files");
+		("editor", po::value<std::string>(_editor)->default_value(editorPath()), "editor for opening test files")
+		("jobs,j", po::value<size_t>(&jobs)->default_value(1), "number of test cases to run in parallel (semantic tests always run one at a time)")
+		("timing-report", po::value<fs::path>(&timingReport), "write the wall time of every test case to this file as JSON");
 
 }
 
@@ -70,5 +73,15 @@ bool IsolTestOptions::parse(int _argc, char const* const* _argv)
 	return res;
 }
 
+void IsolTestOptions::validate() const
+{
+	CommonOptions::validate();
+
+	assertThrow(jobs >= 1, ConfigException, "The --jobs argument must be at least one.");
+#if defined(_WIN32)
+	assertThrow(jobs == 1, ConfigException, "Running tests in parallel is not supported on Windows.");
+#endif
+}
+
 }
 }
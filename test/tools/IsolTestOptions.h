@@ -32,9 +32,14 @@ struct IsolTestOptions: CommonOptions
 {
 	bool noColor = false;
 	bool showHelp = false;
+	/// Number of worker processes that run test cases concurrently.
+	size_t jobs = 1;
+	/// If non-empty, a JSON report with the wall time of every test case is written here.
+	boost::filesystem::path timingReport;
 
 	IsolTestOptions(std::string* _editor);
 	bool parse(int _argc, char const* const* _argv) override;
+	void validate() const override;
 };
 }
 }
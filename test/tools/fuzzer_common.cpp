@@ -21,6 +21,7 @@
 #include <libevmasm/Assembly.h>
 #include <libevmasm/ConstantOptimiser.h>
 #include <libsolc/libsolc.h>
+#include <libsolidity/interface/StandardCompiler.h>
 
 #include <sstream>
 
@@ -28,6 +29,28 @@ using namespace std;
 using namespace dev;
 using namespace dev::eth;
 
+namespace
+{
+
+void checkOutputErrors(Json::Value const& _output)
+{
+	if (_output.isMember("errors"))
+		for (auto const& error: _output["errors"])
+		{
+			string invalid = findAnyOf(error["type"].asString(), vector<string>{
+					"Exception",
+					"InternalCompilerError"
+			});
+			if (!invalid.empty())
+			{
+				cout << "Invalid error: \"" << error["type"].asString() << "\"" << endl;
+				abort();
+			}
+		}
+}
+
+}
+
 void FuzzerUtil::runCompiler(string const& _input, bool _quiet)
 {
 	if (!_quiet)
@@ -45,19 +68,7 @@ void FuzzerUtil::runCompiler(string const& _input, bool _quiet)
 		cout << "Compiler produced invalid JSON output." << endl;
 		abort();
 	}
-	if (output.isMember("errors"))
-		for (auto const& error: output["errors"])
-		{
-			string invalid = findAnyOf(error["type"].asString(), vector<string>{
-					"Exception",
-					"InternalCompilerError"
-			});
-			if (!invalid.empty())
-			{
-				cout << "Invalid error: \"" << error["type"].asString() << "\"" << endl;
-				abort();
-			}
-		}
+	checkOutputErrors(output);
 }
 
 void FuzzerUtil::testCompiler(string const& _input, bool _optimize, bool _quiet)
@@ -80,7 +91,15 @@ void FuzzerUtil::testCompiler(string const& _input, bool _optimize, bool _quiet)
 	// Enable all Contract-level outputs.
 	config["settings"]["outputSelection"]["*"]["*"][0] = "*";
 
-	runCompiler(jsonCompactPrint(config), _quiet);
+	// Hand the configuration to the compiler directly: printing and parsing the input and
+	// output JSON takes about a tenth of the time spent per input.
+	static solidity::StandardCompiler compiler;
+	if (!_quiet)
+		cout << "Input JSON: " << jsonCompactPrint(config) << endl;
+	Json::Value output = compiler.compile(config);
+	if (!_quiet)
+		cout << "Output JSON: " << jsonCompactPrint(output) << endl;
+	checkOutputErrors(output);
 }
 
 void FuzzerUtil::testConstantOptimizer(string const& _input, bool _quiet)
@@ -15,10 +15,21 @@
 	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <libyul/YulString.h>
+
 #include <string>
 
 struct FuzzerUtil
 {
+	/// Persistent fuzzers run all inputs in one process and would keep the Yul names
+	/// of every input interned until they hit their memory limit. This drops all of them
+	/// once there are more than @a _maxStrings. Must only be called between two inputs.
+	static void limitInternedStrings(std::size_t _maxStrings = 200000)
+	{
+		auto& repository = yul::YulStringRepository::instance();
+		if (repository.size() > _maxStrings)
+			repository.reset();
+	}
 	static void runCompiler(std::string const& _input, bool _quiet);
 	static void testCompiler(std::string const& _input, bool _optimize, bool _quiet);
 	static void testConstantOptimizer(std::string const& _input, bool _quiet);
@@ -17,6 +17,7 @@
 
 #include <libdevcore/CommonIO.h>
 #include <libdevcore/AnsiColorized.h>
+#include <libdevcore/JSON.h>
 
 #include <test/Common.h>
 #include <test/tools/IsolTestOptions.h>
@@ -28,13 +29,23 @@
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 
+#include <atomic>
+#include <cerrno>
+#include <chrono>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <fstream>
+#include <map>
 #include <queue>
 
 #if defined(_WIN32)
 #include <windows.h>
+#else
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
 #endif
 
 using namespace dev;
@@ -45,17 +56,27 @@ using namespace std;
 namespace po = boost::program_options;
 namespace fs = boost::filesystem;
 
+struct TestTiming
+{
+	string suite;
+	string path;
+	string result;
+	double seconds;
+};
+
 struct TestStats
 {
 	int successCount = 0;
 	int testCount = 0;
 	int skippedCount = 0;
+	vector<TestTiming> timings;
 	operator bool() const noexcept { return successCount + skippedCount == testCount; }
-	TestStats& operator+=(TestStats const& _other) noexcept
+	TestStats& operator+=(TestStats const& _other)
 	{
 		successCount += _other.successCount;
 		testCount += _other.testCount;
 		skippedCount += _other.skippedCount;
+		timings += _other.timings;
 		return *this;
 	}
 };
@@ -83,13 +104,17 @@ public:
 
 	Result process();
 
+	/// Runs all test cases below @a _path. With more than one job, they are first run by
+	/// worker processes and the results are reported in the same order as when running them
+	/// one after the other. Failing test cases are then run again for interactive handling.
 	static TestStats processPath(
 		TestCase::TestCaseCreator _testCaseCreator,
 		fs::path const& _basepath,
 		fs::path const& _path,
 		string const& _ipcPath,
 		bool _formatted,
-		langutil::EVMVersion _evmVersion
+		langutil::EVMVersion _evmVersion,
+		size_t _jobs
 	);
 
 	static string editor;
@@ -98,11 +123,34 @@ private:
 	{
 		Skip,
 		Rerun,
-		Quit
+		Quit,
+		/// Keep the failure and go on without asking.
+		Continue
+	};
+
+	/// Outcome of a test case run by a worker process, including everything it printed.
+	struct Outcome
+	{
+		Result result;
+		double seconds;
+		string output;
 	};
 
 	Request handleResponse(bool _exception);
 
+	/// @returns the test files below @a _path, breadth first and sorted by name in each directory.
+	static vector<fs::path> testPaths(fs::path const& _basepath, fs::path const& _path);
+	/// Runs @a _runTest for each path in @a _jobs worker processes, which take the next
+	/// test case from a counter in shared memory.
+	/// @returns the outcomes reported back, indexed like @a _paths. Test cases whose
+	/// worker crashed are missing.
+	static map<size_t, Outcome> runInWorkers(
+		vector<fs::path> const& _paths,
+		size_t _jobs,
+		function<Outcome(fs::path const&)> const& _runTest
+	);
+	static string resultName(Result _result);
+
 	TestCase::TestCaseCreator m_testCaseCreator;
 	string const m_name;
 	fs::path const m_path;
@@ -111,10 +159,12 @@ private:
 	langutil::EVMVersion const m_evmVersion;
 	unique_ptr<TestCase> m_test;
 	static bool m_exitRequested;
+	static bool m_inputClosed;
 };
 
 string TestTool::editor;
 bool TestTool::m_exitRequested = false;
+bool TestTool::m_inputClosed = false;
 
 TestTool::Result TestTool::process()
 {
@@ -205,87 +255,295 @@ TestTool::Request TestTool::handleResponse(bool _exception)
 		case 'q':
 			cout << endl;
 			return Request::Quit;
+		case EOF:
+			// Nobody to ask anymore, e.g. in scripts: run the remaining tests and report failures.
+			cout << endl;
+			m_inputClosed = true;
+			return Request::Continue;
 		default:
 			break;
 		}
 	}
 }
 
-TestStats TestTool::processPath(
-	TestCase::TestCaseCreator _testCaseCreator,
-	fs::path const& _basepath,
-	fs::path const& _path,
-	string const& _ipcPath,
-	bool _formatted,
-	langutil::EVMVersion _evmVersion
-)
+string TestTool::resultName(Result _result)
+{
+	switch (_result)
+	{
+	case Result::Success:
+		return "success";
+	case Result::Failure:
+		return "failure";
+	case Result::Exception:
+		return "exception";
+	case Result::Skipped:
+		return "skipped";
+	}
+	return "";
+}
+
+vector<fs::path> TestTool::testPaths(fs::path const& _basepath, fs::path const& _path)
 {
+	vector<fs::path> testPaths;
 	std::queue<fs::path> paths;
 	paths.push(_path);
-	int successCount = 0;
-	int testCount = 0;
-	int skippedCount = 0;
 
 	while (!paths.empty())
 	{
 		auto currentPath = paths.front();
+		paths.pop();
 
 		fs::path fullpath = _basepath / currentPath;
 		if (fs::is_directory(fullpath))
 		{
-			paths.pop();
+			vector<fs::path> entries;
 			for (auto const& entry: boost::iterator_range<fs::directory_iterator>(
 				fs::directory_iterator(fullpath),
 				fs::directory_iterator()
 			))
 				if (fs::is_directory(entry.path()) || TestCase::isTestFilename(entry.path().filename()))
-					paths.push(currentPath / entry.path().filename());
+					entries.push_back(entry.path().filename());
+			sort(entries.begin(), entries.end());
+			for (auto const& entry: entries)
+				paths.push(currentPath / entry);
 		}
-		else if (m_exitRequested)
+		else
+			testPaths.push_back(currentPath);
+	}
+
+	return testPaths;
+}
+
+#if defined(_WIN32)
+map<size_t, TestTool::Outcome> TestTool::runInWorkers(
+	vector<fs::path> const&,
+	size_t,
+	function<Outcome(fs::path const&)> const&
+)
+{
+	// Rejected when validating the options.
+	return {};
+}
+#else
+namespace
+{
+
+void writeAll(int _fd, void const* _data, size_t _size)
+{
+	auto data = static_cast<char const*>(_data);
+	while (_size > 0)
+	{
+		ssize_t written = write(_fd, data, _size);
+		if (written < 0 && errno == EINTR)
+			continue;
+		if (written <= 0)
+			_exit(1);
+		data += written;
+		_size -= size_t(written);
+	}
+}
+
+/// Reads a value of type @a T at @a _pos in @a _data and advances @a _pos.
+/// @returns false if there are not enough bytes left.
+template <class T>
+bool readValue(string const& _data, size_t& _pos, T& _value)
+{
+	if (_data.size() - _pos < sizeof(T))
+		return false;
+	memcpy(&_value, _data.data() + _pos, sizeof(T));
+	_pos += sizeof(T);
+	return true;
+}
+
+}
+
+map<size_t, TestTool::Outcome> TestTool::runInWorkers(
+	vector<fs::path> const& _paths,
+	size_t _jobs,
+	function<Outcome(fs::path const&)> const& _runTest
+)
+{
+	void* sharedMemory = mmap(nullptr, sizeof(atomic<size_t>), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (sharedMemory == MAP_FAILED)
+		return {};
+	auto nextTest = new (sharedMemory) atomic<size_t>(0);
+
+	// Anything still buffered would otherwise be printed again by every worker.
+	cout.flush();
+	cerr.flush();
+
+	vector<pid_t> workers;
+	vector<pollfd> pipes;
+	for (size_t job = 0; job < min(_jobs, _paths.size()); ++job)
+	{
+		int fds[2];
+		if (pipe(fds) != 0)
+			break;
+		pid_t pid = fork();
+		if (pid == 0)
 		{
-			++testCount;
-			paths.pop();
+			close(fds[0]);
+			for (size_t index = (*nextTest)++; index < _paths.size(); index = (*nextTest)++)
+			{
+				Outcome outcome = _runTest(_paths[index]);
+				uint64_t const indexValue = index;
+				int32_t const resultValue = static_cast<int32_t>(outcome.result);
+				uint64_t const outputSize = outcome.output.size();
+				writeAll(fds[1], &indexValue, sizeof(indexValue));
+				writeAll(fds[1], &resultValue, sizeof(resultValue));
+				writeAll(fds[1], &outcome.seconds, sizeof(outcome.seconds));
+				writeAll(fds[1], &outputSize, sizeof(outputSize));
+				writeAll(fds[1], outcome.output.data(), outcome.output.size());
+			}
+			close(fds[1]);
+			// Skip the destructors of static objects, they belong to the parent process.
+			_exit(0);
 		}
-		else
+		close(fds[1]);
+		if (pid < 0)
 		{
-			++testCount;
-			TestTool testTool(_testCaseCreator, currentPath.string(), fullpath, _ipcPath, _formatted, _evmVersion);
-			auto result = testTool.process();
+			close(fds[0]);
+			break;
+		}
+		workers.push_back(pid);
+		pipes.push_back(pollfd{fds[0], POLLIN, 0});
+	}
 
-			switch(result)
+	// Read all pipes concurrently, so that no worker blocks on a full pipe.
+	vector<string> received(pipes.size());
+	size_t openPipes = pipes.size();
+	while (openPipes > 0)
+	{
+		if (poll(pipes.data(), pipes.size(), -1) < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+		for (size_t i = 0; i < pipes.size(); ++i)
+			if (pipes[i].fd >= 0 && pipes[i].revents != 0)
 			{
-			case Result::Failure:
-			case Result::Exception:
-				switch(testTool.handleResponse(result == Result::Exception))
+				char buffer[4096];
+				ssize_t bytes = read(pipes[i].fd, buffer, sizeof(buffer));
+				if (bytes > 0)
+					received[i].append(buffer, size_t(bytes));
+				else if (bytes == 0 || errno != EINTR)
+				{
+					close(pipes[i].fd);
+					pipes[i].fd = -1;
+					--openPipes;
+				}
+			}
+	}
+	for (pid_t worker: workers)
+		waitpid(worker, nullptr, 0);
+	munmap(sharedMemory, sizeof(atomic<size_t>));
+
+	map<size_t, Outcome> outcomes;
+	for (string const& data: received)
+	{
+		size_t pos = 0;
+		uint64_t index;
+		int32_t result;
+		double seconds;
+		uint64_t outputSize;
+		while (
+			readValue(data, pos, index) &&
+			readValue(data, pos, result) &&
+			readValue(data, pos, seconds) &&
+			readValue(data, pos, outputSize) &&
+			data.size() - pos >= outputSize
+		)
+		{
+			outcomes[index] = Outcome{static_cast<Result>(result), seconds, data.substr(pos, outputSize)};
+			pos += outputSize;
+		}
+	}
+	return outcomes;
+}
+#endif
+
+TestStats TestTool::processPath(
+	TestCase::TestCaseCreator _testCaseCreator,
+	fs::path const& _basepath,
+	fs::path const& _path,
+	string const& _ipcPath,
+	bool _formatted,
+	langutil::EVMVersion _evmVersion,
+	size_t _jobs
+)
+{
+	vector<fs::path> const paths = testPaths(_basepath, _path);
+	map<size_t, Outcome> outcomes;
+	if (_jobs > 1 && !m_exitRequested)
+		outcomes = runInWorkers(paths, _jobs, [&](fs::path const& _currentPath) {
+			ostringstream output;
+			auto coutBuffer = cout.rdbuf(output.rdbuf());
+			auto start = chrono::steady_clock::now();
+			TestTool testTool(_testCaseCreator, _currentPath.string(), _basepath / _currentPath, _ipcPath, _formatted, _evmVersion);
+			Result result = testTool.process();
+			double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+			cout.rdbuf(coutBuffer);
+			return Outcome{result, seconds, output.str()};
+		});
+
+	TestStats stats;
+	auto record = [&](fs::path const& _currentPath, Result _result, double _seconds) {
+		if (_result == Result::Success)
+			++stats.successCount;
+		else if (_result == Result::Skipped)
+			++stats.skippedCount;
+		stats.timings.push_back(TestTiming{{}, _currentPath.string(), resultName(_result), _seconds});
+	};
+
+	for (size_t i = 0; i < paths.size(); ++i)
+	{
+		fs::path const& currentPath = paths[i];
+		++stats.testCount;
+
+		auto outcome = outcomes.find(i);
+		bool const failed = outcome != outcomes.end() && (
+			outcome->second.result == Result::Failure ||
+			outcome->second.result == Result::Exception
+		);
+		if (outcome != outcomes.end() && (!failed || m_exitRequested || m_inputClosed))
+		{
+			cout << outcome->second.output;
+			record(currentPath, outcome->second.result, outcome->second.seconds);
+			continue;
+		}
+		if (m_exitRequested)
+			continue;
+
+		while (true)
+		{
+			auto start = chrono::steady_clock::now();
+			TestTool testTool(_testCaseCreator, currentPath.string(), _basepath / currentPath, _ipcPath, _formatted, _evmVersion);
+			auto result = testTool.process();
+			double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+			if (result == Result::Failure || result == Result::Exception)
+				switch(m_inputClosed ? Request::Continue : testTool.handleResponse(result == Result::Exception))
 				{
 				case Request::Quit:
-					paths.pop();
 					m_exitRequested = true;
 					break;
 				case Request::Rerun:
 					cout << "Re-running test case..." << endl;
-					--testCount;
-					break;
+					continue;
 				case Request::Skip:
-					paths.pop();
-					++skippedCount;
+					// Counted and reported as skipped by the user.
+					result = Result::Skipped;
+					break;
+				case Request::Continue:
 					break;
 				}
-				break;
-			case Result::Success:
-				paths.pop();
-				++successCount;
-				break;
-			case Result::Skipped:
-				paths.pop();
-				++skippedCount;
-				break;
-			}
+			record(currentPath, result, seconds);
+			break;
 		}
 	}
 
-	return { successCount, testCount, skippedCount };
-
+	return stats;
 }
 
 namespace
@@ -318,7 +576,8 @@ boost::optional<TestStats> runTestSuite(
 	string const& _ipcPath,
 	TestCase::TestCaseCreator _testCaseCreator,
 	bool _formatted,
-	langutil::EVMVersion _evmVersion
+	langutil::EVMVersion _evmVersion,
+	size_t _jobs
 )
 {
 	fs::path testPath = _basePath / _subdirectory;
@@ -329,7 +588,9 @@ boost::optional<TestStats> runTestSuite(
 		return {};
 	}
 
-	TestStats stats = TestTool::processPath(_testCaseCreator, _basePath, _subdirectory, _ipcPath, _formatted, _evmVersion);
+	TestStats stats = TestTool::processPath(_testCaseCreator, _basePath, _subdirectory, _ipcPath, _formatted, _evmVersion, _jobs);
+	for (auto& timing: stats.timings)
+		timing.suite = _name;
 
 	cout << endl << _name << " Test Summary: ";
 	AnsiColorized(cout, _formatted, {BOLD, stats ? GREEN : RED}) <<
@@ -348,6 +609,32 @@ boost::optional<TestStats> runTestSuite(
 	return stats;
 }
 
+/// Writes the wall time of every test case to @a _path, slowest first.
+bool writeTimingReport(fs::path const& _path, vector<TestTiming> _timings, size_t _jobs, double _seconds)
+{
+	stable_sort(_timings.begin(), _timings.end(), [](TestTiming const& _a, TestTiming const& _b) {
+		return _a.seconds > _b.seconds;
+	});
+
+	Json::Value report{Json::objectValue};
+	report["jobs"] = Json::UInt64(_jobs);
+	report["seconds"] = _seconds;
+	report["tests"] = Json::arrayValue;
+	for (auto const& timing: _timings)
+	{
+		Json::Value test{Json::objectValue};
+		test["suite"] = timing.suite;
+		test["path"] = timing.path;
+		test["result"] = timing.result;
+		test["seconds"] = timing.seconds;
+		report["tests"].append(test);
+	}
+
+	ofstream file(_path.string(), ios::trunc);
+	file << jsonPrettyPrint(report) << endl;
+	return bool(file);
+}
+
 }
 
 int main(int argc, char const *argv[])
@@ -369,7 +656,8 @@ int main(int argc, char const *argv[])
 		return 1;
 	}
 
-	TestStats global_stats{0, 0};
+	TestStats global_stats;
+	auto start = chrono::steady_clock::now();
 
 	// Actually run the tests.
 	// Interactive tests are added in InteractiveTests.h
@@ -381,7 +669,9 @@ int main(int argc, char const *argv[])
 		if (ts.smt && options.disableSMT)
 			continue;
 
-		if (auto stats = runTestSuite(ts.title, options.testPath / ts.path, ts.subpath, options.ipcPath.string(), ts.testCaseCreator, !options.noColor, options.evmVersion()))
+		// Semantic tests share the state of a single node.
+		size_t const jobs = ts.ipc ? 1 : options.jobs;
+		if (auto stats = runTestSuite(ts.title, options.testPath / ts.path, ts.subpath, options.ipcPath.string(), ts.testCaseCreator, !options.noColor, options.evmVersion(), jobs))
 			global_stats += *stats;
 		else
 			return 1;
@@ -399,5 +689,15 @@ int main(int argc, char const *argv[])
 	}
 	cout << "." << endl;
 
+	if (!options.timingReport.empty())
+	{
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		if (!writeTimingReport(options.timingReport, global_stats.timings, options.jobs, seconds))
+		{
+			cerr << "Could not write the timing report to " << options.timingReport.string() << "." << endl;
+			return 1;
+		}
+	}
+
 	return global_stats ? 0 : 1;
 }
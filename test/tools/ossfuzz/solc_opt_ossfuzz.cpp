@@ -21,6 +21,7 @@ using namespace std;
 
 extern "C" int LLVMFuzzerTestOneInput(uint8_t const* _data, size_t _size)
 {
+	FuzzerUtil::limitInternedStrings();
 	if (_size <= 600)
 	{
 		string input(reinterpret_cast<char const *>(_data), _size);
@@ -15,6 +15,8 @@
 	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <test/tools/fuzzer_common.h>
+
 #include <libyul/AssemblyStack.h>
 #include <liblangutil/EVMVersion.h>
 #include <libyul/backends/evm/EVMCodeTransform.h>
@@ -24,6 +26,7 @@ using namespace std;
 
 extern "C" int LLVMFuzzerTestOneInput(uint8_t const* _data, size_t _size)
 {
+	FuzzerUtil::limitInternedStrings();
 	if (_size > 600)
 		return 0;
 
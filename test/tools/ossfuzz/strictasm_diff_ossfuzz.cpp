@@ -30,6 +30,7 @@
 #include <libdevcore/CommonIO.h>
 #include <libdevcore/CommonData.h>
 
+#include <test/tools/fuzzer_common.h>
 #include <test/tools/ossfuzz/yulFuzzerCommon.h>
 
 #include <string>
@@ -45,6 +46,7 @@ using namespace yul::test::yul_fuzzer;
 
 extern "C" int LLVMFuzzerTestOneInput(uint8_t const* _data, size_t _size)
 {
+	FuzzerUtil::limitInternedStrings();
 	if (_size > 600)
 		return 0;
 
@@ -32,6 +32,7 @@ using namespace std;
 
 DEFINE_PROTO_FUZZER(Function const& _input)
 {
+	FuzzerUtil::limitInternedStrings();
 	ProtoConverter converter;
 	string yul_source = converter.functionToString(_input);
 	if (yul_source.size() > 600)
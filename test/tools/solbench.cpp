@@ -0,0 +1,246 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Micro benchmarks for performance critical components of the compiler.
+ */
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/parsing/Parser.h>
+
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/Scanner.h>
+
+#include <libdevcore/CommonData.h>
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/Keccak256.h>
+#include <libdevcore/SwarmHash.h>
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace dev;
+using namespace langutil;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// Runs @a _work @a _repetitions times and prints the throughput for @a _bytes processed per run.
+void measure(string const& _title, size_t _bytes, size_t _repetitions, function<void()> const& _work)
+{
+	auto start = chrono::steady_clock::now();
+	for (size_t i = 0; i < _repetitions; ++i)
+		_work();
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	double megabytes = double(_bytes) * double(_repetitions) / (1024 * 1024);
+	cout << setw(40) << left << _title << fixed << setprecision(1) << megabytes / seconds << " MB/s" << endl;
+}
+
+void benchmarkKeccak(vector<string> const&)
+{
+	bytes data(16 * 1024 * 1024);
+	for (size_t i = 0; i < data.size(); ++i)
+		data[i] = uint8_t(i * 31);
+	bytesConstRef ref(&data);
+
+	for (size_t chunkSize: {32, 64, 136, 4096})
+	{
+		vector<bytesConstRef> chunks;
+		for (size_t i = 0; i + chunkSize <= data.size(); i += chunkSize)
+			chunks.push_back(ref.cropped(i, chunkSize));
+		measure("keccak256, " + to_string(chunkSize) + " byte inputs", data.size(), 3, [&]() {
+			for (auto const& chunk: chunks)
+				keccak256(chunk);
+		});
+		measure("keccak256Many, " + to_string(chunkSize) + " byte inputs", data.size(), 3, [&]() {
+			keccak256Many(chunks);
+		});
+	}
+	string input(data.begin(), data.end());
+	measure("swarmHash", input.size(), 3, [&]() { swarmHash(input); });
+}
+
+void benchmarkScanner(vector<string> const& _files)
+{
+	if (_files.empty())
+	{
+		cerr << "The scanner benchmark needs at least one source file." << endl;
+		return;
+	}
+
+	vector<shared_ptr<string const>> sources;
+	size_t totalSize = 0;
+	for (string const& file: _files)
+	{
+		sources.push_back(make_shared<string const>(readFileAsString(file)));
+		totalSize += sources.back()->size();
+	}
+
+	size_t tokens = 0;
+	measure("scanner, " + to_string(sources.size()) + " files", totalSize, 10, [&]() {
+		for (auto const& source: sources)
+		{
+			Scanner scanner{CharStream(source, "")};
+			for (; scanner.currentToken() != Token::EOS && scanner.currentToken() != Token::Illegal; scanner.next())
+				++tokens;
+		}
+	});
+	cout << tokens / 10 << " tokens per run" << endl;
+}
+
+void benchmarkParser(vector<string> const& _files)
+{
+	if (_files.empty())
+	{
+		cerr << "The parser benchmark needs at least one source file." << endl;
+		return;
+	}
+
+	vector<shared_ptr<string const>> sources;
+	size_t totalSize = 0;
+	for (string const& file: _files)
+	{
+		sources.push_back(make_shared<string const>(readFileAsString(file)));
+		totalSize += sources.back()->size();
+	}
+
+	// Parsing and tearing down the ASTs are timed separately.
+	size_t const repetitions = 10;
+	double parseSeconds = 0;
+	double teardownSeconds = 0;
+	for (size_t i = 0; i < repetitions; ++i)
+	{
+		langutil::ErrorList errors;
+		langutil::ErrorReporter errorReporter(errors);
+		vector<solidity::ASTPointer<solidity::SourceUnit>> asts;
+		auto start = chrono::steady_clock::now();
+		auto arena = make_shared<Arena>();
+		for (auto const& source: sources)
+			asts.push_back(solidity::Parser(errorReporter, arena).parse(
+				make_shared<Scanner>(CharStream(source, ""))
+			));
+		arena.reset();
+		auto parsed = chrono::steady_clock::now();
+		asts.clear();
+		auto end = chrono::steady_clock::now();
+		parseSeconds += chrono::duration<double>(parsed - start).count();
+		teardownSeconds += chrono::duration<double>(end - parsed).count();
+	}
+	double megabytes = double(totalSize) * double(repetitions) / (1024 * 1024);
+	cout << setw(40) << left << "parser, " + to_string(sources.size()) + " files";
+	cout << fixed << setprecision(1) << megabytes / parseSeconds << " MB/s" << endl;
+	cout << setw(40) << left << "AST teardown";
+	cout << fixed << setprecision(1) << megabytes / teardownSeconds << " MB/s" << endl;
+}
+
+void benchmarkConstants(vector<string> const&)
+{
+	// A contract dominated by constant arithmetic: chained constants and a large lookup table.
+	// The chains are restarted every 200 constants to stay below the depth limit of the
+	// cyclic dependency check.
+	string source = "pragma solidity >=0.0;\ncontract Constants {\n";
+	for (size_t i = 0; i < 1000; ++i)
+		source +=
+			"\tuint constant c" + to_string(i) + " = (" +
+			(i % 200 == 0 ? string("uint(1 ether)") : "c" + to_string(i - 1)) + " + " + to_string(i) + " * 2**" +
+			to_string(i % 200) + " + 3 days) / " + to_string(i % 17 + 1) + " % 2**255;\n";
+	source += "\tuint256[1000] table = [uint256(0)";
+	for (size_t i = 1; i < 1000; ++i)
+		source += ", 0x" + toHex(h256(u256(i) * u256(0x9e3779b97f4a7c15ULL) << (i % 190)).asBytes());
+	source += "];\n}\n";
+
+	measure("constant analysis", source.size(), 10, [&]() {
+		solidity::CompilerStack compiler;
+		compiler.setSources({{"", source}});
+		if (!compiler.parseAndAnalyze())
+			cerr << "Analysis failed." << endl;
+	});
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	map<string, function<void(vector<string> const&)>> const benchmarks{
+		{"constants", benchmarkConstants},
+		{"keccak", benchmarkKeccak},
+		{"parser", benchmarkParser},
+		{"scanner", benchmarkScanner}
+	};
+
+	po::options_description options(
+		R"(solbench, micro benchmarks for the Solidity compiler.
+Usage: solbench [Options] <benchmark> [<file>...]
+Available benchmarks:
+  constants Analysis throughput of a contract full of constant expressions.
+  keccak    Keccak-256 and swarm hash throughput.
+  parser    Parser and AST teardown throughput on the given source files.
+  scanner   Scanner throughput on the given source files.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("benchmark", po::value<string>(), "benchmark to run")
+		("input-file", po::value<vector<string>>(), "input files used by some benchmarks")
+		("help", "Show this help screen.");
+
+	po::positional_options_description positions;
+	positions.add("benchmark", 1);
+	positions.add("input-file", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(positions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help") || !arguments.count("benchmark"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	auto benchmark = benchmarks.find(arguments["benchmark"].as<string>());
+	if (benchmark == benchmarks.end())
+	{
+		cerr << "Unknown benchmark: " << arguments["benchmark"].as<string>() << endl;
+		return 1;
+	}
+
+	vector<string> files;
+	if (arguments.count("input-file"))
+		files = arguments["input-file"].as<vector<string>>();
+	benchmark->second(files);
+	return 0;
+}